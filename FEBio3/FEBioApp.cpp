@@ -38,6 +38,7 @@ SOFTWARE.*/
 #include "febio_cb.h"
 #include "Interrupt.h"
 #include "ping.h"
+#include <FECore/FEProfiler.h>
 
 FEBioApp* FEBioApp::m_This = nullptr;
 
@@ -167,6 +168,16 @@ int FEBioApp::RunModel()
 	fem.SetLogFilename(m_ops.szlog);
 	fem.SetPlotFilename(m_ops.szplt);
 	fem.SetDumpFilename(m_ops.szdmp);
+	fem.SetProfileFilename(m_ops.szprof);
+
+	// setup the profiler
+	if (m_ops.bprofile)
+	{
+		FEProfiler* prof = FEProfiler::GetInstance();
+		prof->Reset();
+		prof->Enable(true);
+		prof->RecordTimeSteps(m_ops.bprofSteps);
+	}
 
 	// read the input file if specified
 	int nret = 0;
@@ -235,12 +246,15 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.bsplash = true;
 	ops.bsilent = false;
 	ops.binteractive = true;
+	ops.bprofile = false;
+	ops.bprofSteps = false;
 
 	// these flags indicate whether the corresponding file name
 	// was defined on the command line. Otherwise, a default name will be generated.
 	bool blog = false;
 	bool bplt = false;
 	bool bdmp = false;
+	bool bprof = false;
 	bool brun = true;
 
 	// initialize file names
@@ -251,6 +265,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.szprof[0] = 0;
 
 	// set initial configuration file name
 	if (ops.szcnf[0] == 0)
@@ -306,6 +321,31 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 				}
 			}
 		}
+		else if (strncmp(sz, "-profile", 8) == 0)
+		{
+			ops.bprofile = true;
+			ops.bprofSteps = false;
+			if (sz[8] == '=')
+			{
+				if (strcmp(sz + 9, "step") == 0) ops.bprofSteps = true;
+				else
+				{
+					fprintf(stderr, "FATAL ERROR: invalid profile option.\n");
+					return false;
+				}
+			}
+
+			if (i<nargs - 1)
+			{
+				char* szi = argv[i + 1];
+				if (szi[0] != '-')
+				{
+					// assume this is the name of the profiler report
+					strcpy(ops.szprof, argv[++i]);
+					bprof = true;
+				}
+			}
+		}
 		else if (strcmp(sz, "-o") == 0)
 		{
 			blog = true;
@@ -472,6 +512,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szlogbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprof && ops.bprofile) sprintf(ops.szprof, "%s_profile.json", szbase);
 	}
 	else if (ops.szctrl[0])
 	{
@@ -483,6 +524,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprof && ops.bprofile) sprintf(ops.szprof, "%s_profile.json", szbase);
 	}
 
 	return brun;
@@ -41,6 +41,9 @@ struct CMDOPTIONS
 
 	int		dumpLevel;		//!< requested restart level
 
+	bool	bprofile;		//!< collect profiling data
+	bool	bprofSteps;		//!< store profiling data for each time step
+
 	char	szfile[MAXFILE];	//!< model input file name
 	char	szlog[MAXFILE];	//!< log file name
 	char	szplt[MAXFILE];	//!< plot file name
@@ -49,6 +52,7 @@ struct CMDOPTIONS
 	char	sztask[MAXFILE];	//!< task name
 	char	szctrl[MAXFILE];	//!< control file for tasks
 	char	szimp[MAXFILE];		//!< import file
+	char	szprof[MAXFILE];	//!< profiler report file
 
 	CMDOPTIONS()
 	{
@@ -62,6 +66,8 @@ struct CMDOPTIONS
 		bsilent = false;
 		binteractive = false;
 		dumpLevel = 0;
+		bprofile = false;
+		bprofSteps = false;
 
 		szfile[0] = 0;
 		szlog[0] = 0;
@@ -71,5 +77,6 @@ struct CMDOPTIONS
 		sztask[0] = 0;
 		szctrl[0] = 0;
 		szimp[0] = 0;
+		szprof[0] = 0;
 	}
 };
@@ -643,7 +643,8 @@ void FEBiphasicFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo
         
         if (el.isActive()) {
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -654,7 +655,7 @@ void FEBiphasicFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo
             ElementStiffness(el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -676,7 +677,8 @@ void FEBiphasicFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         
         if (el.isActive()) {
             
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -687,7 +689,7 @@ void FEBiphasicFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
             ElementMassMatrix(el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -711,7 +713,8 @@ void FEBiphasicFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeI
         if (el.isActive()) {
             
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -722,7 +725,7 @@ void FEBiphasicFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeI
             ElementBodyForceStiffness(bf, el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -463,7 +463,8 @@ void FEFluidDomain2D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		FEElement2D& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 
         // create the element's stiffness matrix
         int ndof = 3*el.Nodes();
@@ -474,7 +475,7 @@ void FEFluidDomain2D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         ElementMaterialStiffness(el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -495,7 +496,8 @@ void FEFluidDomain2D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		FEElement2D& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 3*el.Nodes();
@@ -506,7 +508,7 @@ void FEFluidDomain2D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         ElementMassMatrix(el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -529,7 +531,8 @@ void FEFluidDomain2D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo& t
 		FEElement2D& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 3*el.Nodes();
@@ -540,7 +543,7 @@ void FEFluidDomain2D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo& t
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -445,7 +445,8 @@ void FEFluidDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
@@ -456,7 +457,7 @@ void FEFluidDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         ElementStiffness(el, ke, tp);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -476,7 +477,8 @@ void FEFluidDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
@@ -487,7 +489,7 @@ void FEFluidDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         ElementMassMatrix(el, ke, tp);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -507,7 +509,8 @@ void FEFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo& t
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
@@ -518,7 +521,7 @@ void FEFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo& t
         ElementBodyForceStiffness(bf, el, ke, tp);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
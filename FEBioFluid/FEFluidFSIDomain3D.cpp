@@ -569,7 +569,8 @@ void FEFluidFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& t
         
         if (el.isActive()) {
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -580,7 +581,7 @@ void FEFluidFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& t
             ElementStiffness(el, ke, tp);
             
             // get the element's LM vector
-			vector<int> lm;
+			static thread_local vector<int> lm;
 			UnpackLM(el, lm);
 			ke.SetIndices(lm);
             
@@ -602,7 +603,8 @@ void FEFluidFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         
         if (el.isActive()) {
 
-			FEElementMatrix ke(el);
+			static thread_local FEElementMatrix ke;
+			ke.SetElement(el);
 
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -613,7 +615,7 @@ void FEFluidFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
             ElementMassMatrix(el, ke, tp);
             
             // get the element's LM vector
-			vector<int> lm;
+			static thread_local vector<int> lm;
 			UnpackLM(el, lm);
 			ke.SetIndices(lm);
             
@@ -637,7 +639,8 @@ void FEFluidFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo
         if (el.isActive()) {
 
 			// element stiffness matrix
-			FEElementMatrix ke(el);
+			static thread_local FEElementMatrix ke;
+			ke.SetElement(el);
 
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
@@ -648,7 +651,7 @@ void FEFluidFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeInfo
             ElementBodyForceStiffness(bf, el, ke, tp);
             
             // get the element's LM vector
-			vector<int> lm;
+			static thread_local vector<int> lm;
 			UnpackLM(el, lm);
 			ke.SetIndices(lm);
             
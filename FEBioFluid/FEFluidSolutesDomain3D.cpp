@@ -893,7 +893,8 @@ void FEFluidSolutesDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int nsol = m_pMat->Solutes();
@@ -906,7 +907,7 @@ void FEFluidSolutesDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
         ElementStiffness(el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
@@ -926,7 +927,8 @@ void FEFluidSolutesDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         const int nsol = m_pMat->Solutes();
@@ -939,7 +941,7 @@ void FEFluidSolutesDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp
         ElementMassMatrix(el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
@@ -959,7 +961,8 @@ void FEFluidSolutesDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETime
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         const int nsol = m_pMat->Solutes();
@@ -972,7 +975,7 @@ void FEFluidSolutesDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETime
         ElementBodyForceStiffness(bf, el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
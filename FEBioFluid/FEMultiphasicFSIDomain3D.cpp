@@ -1243,7 +1243,8 @@ void FEMultiphasicFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeI
         
         if (el.isActive()) {
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
@@ -1254,7 +1255,7 @@ void FEMultiphasicFSIDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeI
             ElementStiffness(el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -1279,7 +1280,8 @@ void FEMultiphasicFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo&
         
         if (el.isActive()) {
             
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
@@ -1290,7 +1292,7 @@ void FEMultiphasicFSIDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo&
             ElementMassMatrix(el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -1318,7 +1320,8 @@ void FEMultiphasicFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETi
         if (el.isActive()) {
             
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            static thread_local FEElementMatrix ke;
+            ke.SetElement(el);
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
@@ -1329,7 +1332,7 @@ void FEMultiphasicFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETi
             ElementBodyForceStiffness(bf, el, ke, tp);
             
             // get the element's LM vector
-            vector<int> lm;
+            static thread_local vector<int> lm;
             UnpackLM(el, lm);
             ke.SetIndices(lm);
             
@@ -442,7 +442,8 @@ void FESolutesDomain::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 
 		// create the element's stiffness matrix
 		int nsol = m_pMat->Solutes();
@@ -454,7 +455,7 @@ void FESolutesDomain::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 		ElementStiffness(el, ke, tp);
 
 		// get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
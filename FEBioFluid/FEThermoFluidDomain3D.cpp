@@ -613,7 +613,8 @@ void FEThermoFluidDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
@@ -624,7 +625,7 @@ void FEThermoFluidDomain3D::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo
         ElementStiffness(el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
 
@@ -644,7 +645,8 @@ void FEThermoFluidDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
@@ -655,7 +657,7 @@ void FEThermoFluidDomain3D::MassMatrix(FELinearSystem& LS, const FETimeInfo& tp)
         ElementMassMatrix(el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
@@ -675,7 +677,8 @@ void FEThermoFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeI
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
@@ -686,7 +689,7 @@ void FEThermoFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, const FETimeI
         ElementBodyForceStiffness(bf, el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
@@ -706,7 +709,8 @@ void FEThermoFluidDomain3D::HeatSupplyStiffness(FELinearSystem& LS, const FETime
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
@@ -717,7 +721,7 @@ void FEThermoFluidDomain3D::HeatSupplyStiffness(FELinearSystem& LS, const FETime
         ElementHeatSupplyStiffness(bf, el, ke, tp);
         
         // get the element's LM vector
-        vector<int> lm;
+        static thread_local vector<int> lm;
         UnpackLM(el, lm);
         ke.SetIndices(lm);
         
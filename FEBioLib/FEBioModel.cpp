@@ -56,15 +56,15 @@ SOFTWARE.*/
 #include <FECore/LinearSolver.h>
 #include <FECore/FEDomain.h>
 #include <FECore/FEMaterial.h>
+#include <FECore/FEProfiler.h>
 #include "febio.h"
 #include "version.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
 
-#ifdef WIN32
 size_t FEBIOLIB_API GetPeakMemory();	// in memory.cpp
-#endif
+size_t FEBIOLIB_API GetCurrentMemory();	// in memory.cpp
 
 FEBioModel::FEPlotVariable::FEPlotVariable()
 {
@@ -121,6 +121,9 @@ bool output_cb(FEModel* pfem, unsigned int nwhen, void* pd)
 	// write plot file
 	pfebio->Write(nwhen);
 
+	// update profiler
+	pfebio->UpdateProfiler(nwhen);
+
 	return true;
 }
 
@@ -144,6 +147,7 @@ FEBioModel::FEBioModel()
 	m_ntotalReforms = 0;
 
 	m_pltCompression = 0;
+	m_pltAsync = false;
 	m_pltAppendOnRestart = true;
 
 	m_lastUpdate = -1;
@@ -268,6 +272,13 @@ void FEBioModel::SetDumpFilename(const std::string& sfile)
 	m_sdump = sfile;
 }
 
+//-----------------------------------------------------------------------------
+//! Set the name of the profiler report
+void FEBioModel::SetProfileFilename(const std::string& sfile)
+{
+	m_sprofile = sfile;
+}
+
 //-----------------------------------------------------------------------------
 //! Return the name of the input file
 const std::string& FEBioModel::GetInputFileName()
@@ -296,6 +307,13 @@ const std::string& FEBioModel::GetDumpFileName()
 	return	m_sdump;
 }
 
+//-----------------------------------------------------------------------------
+//! Return the profiler report file name.
+const std::string& FEBioModel::GetProfileFileName()
+{
+	return m_sprofile;
+}
+
 //-----------------------------------------------------------------------------
 //! get the file title (i.e. name of input file without the path)
 const std::string& FEBioModel::GetFileTitle()
@@ -328,6 +346,7 @@ bool FEBioModel::Input(const char* szfile)
 {
 	// start the timer
 	TimerTracker t(&m_InputTime);
+	FE_PROFILE("input");
 
 	// create file reader
 	FEBioImport fim;
@@ -361,6 +380,7 @@ bool FEBioModel::Input(const char* szfile)
 
 		// set compression
 		m_pltCompression = fim.m_nplot_compression;
+		m_pltAsync = fim.m_bplot_async;
 
 		// define the plot file variables
 		FEModel& fem = *GetFEModel();
@@ -489,6 +509,7 @@ void FEBioModel::WriteLog(unsigned int nwhen)
 void FEBioModel::Write(unsigned int nwhen)
 {
 	TimerTracker t(&m_IOTimer);
+	FE_PROFILE("output");
 
 	// get the current step
 	FEAnalysis* pstep = GetCurrentStep();
@@ -705,10 +726,30 @@ void FEBioModel::DumpData()
 	else 
 	{
 		Serialize(ar);
+		FEProfiler::GetInstance()->AddCount("restart file bytes", (double)ar.bytesSerialized());
 		feLogInfo("\nRestart point created. Archive name is %s.", m_sdump.c_str());
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Store the memory stats and, if requested, the profiler data for each converged time step
+void FEBioModel::UpdateProfiler(unsigned int nwhen)
+{
+	FEProfiler* prof = FEProfiler::GetInstance();
+	if ((prof->IsEnabled() == false) || (nwhen != CB_MAJOR_ITERS)) return;
+
+	prof->SetValue("peak memory (MB)", (double)GetPeakMemory() / 1048576.0);
+	prof->SetValue("current memory (MB)", (double)GetCurrentMemory() / 1048576.0);
+
+	if (prof->RecordingTimeSteps())
+	{
+		// m_ntimeSteps is only updated at the end of a step
+		FEAnalysis* step = GetCurrentStep();
+		int nstep = m_ntimeSteps + (step ? step->m_ntimesteps : 0);
+		prof->RecordTimeStep(nstep, GetCurrentTime());
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEBioModel::Log(int ntag, const char* szmsg)
 {
@@ -1294,6 +1335,9 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		FEBioPlotFile* pplt = new FEBioPlotFile(*this);
 		m_plot = pplt;
 
+		// write states in the background if requested
+		pplt->SetAsyncWriting(m_pltAsync);
+
 		if (m_pltAppendOnRestart)
 		{
 			// Open for appending
@@ -1386,6 +1430,7 @@ void FEBioModel::SerializeDataStore(DumpStream& ar)
 bool FEBioModel::Init()
 {
 	TimerTracker t(&m_InitTime);
+	FE_PROFILE("init");
 
 	// Open the logfile
 	if (m_logLevel != 0)
@@ -1408,6 +1453,9 @@ bool FEBioModel::Init()
 			// set compression
 			pplt->SetCompression(m_pltCompression);
 
+			// write states in the background if requested
+			pplt->SetAsyncWriting(m_pltAsync);
+
 			// set the software string
 			const char* szver = febio::getVersionString();
 			char szbuf[256] = { 0 };
@@ -1602,20 +1650,34 @@ bool FEBioModel::Solve()
 	m_SolveTime.start();
 
 	// solve the FE model
-	bool bconv = FEMechModel::Solve();
+	bool bconv = false;
+	{
+		FE_PROFILE("solve");
+		bconv = FEMechModel::Solve();
+	}
 
 	// stop total time tracker
 	m_SolveTime.stop();
 
 	// get peak memory usage
-#ifdef WIN32
 	size_t memsize = GetPeakMemory();
 	if (memsize != 0)
 	{
 		double mb = (double)memsize / 1048576.0;
 		feLog(" Peak memory  : %.1lf MB\n", mb);
 	}
-#endif
+
+	// write the profiler report
+	FEProfiler* prof = FEProfiler::GetInstance();
+	if (prof->IsEnabled() && (m_sprofile.empty() == false))
+	{
+		prof->SetValue("peak memory (MB)", (double)memsize / 1048576.0);
+		prof->SetValue("current memory (MB)", (double)GetCurrentMemory() / 1048576.0);
+		if (prof->WriteReport(m_sprofile.c_str()) == false)
+		{
+			feLogWarning("Failed writing profiler report (%s).", m_sprofile.c_str());
+		}
+	}
 
 	// print the elapsed time
 	char sztime[64];
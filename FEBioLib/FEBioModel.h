@@ -100,6 +100,9 @@ public: // --- I/O functions ---
 	//! dump data to archive for restart
 	void DumpData();
 
+	//! update the profiler's memory stats and time step data
+	void UpdateProfiler(unsigned int nwhen);
+
 	//! add to log 
 	void Log(int ntag, const char* szmsg) override;
 
@@ -141,12 +144,14 @@ public: // --- I/O functions ---
 	void SetLogFilename  (const std::string& sfile);
 	void SetPlotFilename (const std::string& sfile);
 	void SetDumpFilename (const std::string& sfile);
+	void SetProfileFilename(const std::string& sfile);
 
 	//! Get the I/O file names
 	const std::string& GetInputFileName();
 	const std::string& GetLogfileName  ();
 	const std::string& GetPlotFileName ();
 	const std::string& GetDumpFileName ();
+	const std::string& GetProfileFileName();
 
 	//! get the file title
 	const std::string& GetFileTitle();
@@ -219,12 +224,14 @@ protected: // file names
 	std::string		m_splot;			//!< plot output file name
 	std::string		m_slog ;			//!< log output file name
 	std::string		m_sdump;			//!< dump file name
+	std::string		m_sprofile;			//!< profiler report file name
 
 	std::string	m_title;	//!< model title
 
 protected:
 	vector<FEPlotVariable>	m_pltData;
 	int						m_pltCompression;
+	bool					m_pltAsync;
 	bool					m_pltAppendOnRestart;
 	int						m_lastUpdate;
 
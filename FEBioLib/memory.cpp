@@ -29,14 +29,66 @@ SOFTWARE.*/
 #ifdef WIN32
 #include <windows.h>
 #include <psapi.h>
+#elif defined(LINUX)
+#include <stdio.h>
+#include <string.h>
+#else
+#include <sys/resource.h>
 #endif
 
+#ifdef LINUX
+//-----------------------------------------------------------------------------
+// read a memory value (reported in kB) from /proc/self/status
+static size_t read_proc_status(const char* szkey)
+{
+	FILE* fp = fopen("/proc/self/status", "rt");
+	if (fp == nullptr) return 0;
+
+	size_t l = strlen(szkey);
+	size_t val = 0;
+	char szline[256];
+	while (fgets(szline, sizeof(szline), fp))
+	{
+		if (strncmp(szline, szkey, l) == 0)
+		{
+			unsigned long kb = 0;
+			if (sscanf(szline + l, " %lu", &kb) == 1) val = (size_t)kb * 1024;
+			break;
+		}
+	}
+	fclose(fp);
+	return val;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// returns the peak memory usage (in bytes) of this process
 size_t FEBIOLIB_API GetPeakMemory()
 {
 #ifdef WIN32
 	PROCESS_MEMORY_COUNTERS memCounters;
 	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
 	return (size_t)memCounters.PeakWorkingSetSize;
+#elif defined(LINUX)
+	return read_proc_status("VmHWM:");
+#else
+	// ru_maxrss is reported in bytes on macOS
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+	return (size_t)usage.ru_maxrss;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// returns the current memory usage (in bytes) of this process
+size_t FEBIOLIB_API GetCurrentMemory()
+{
+#ifdef WIN32
+	PROCESS_MEMORY_COUNTERS memCounters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
+	return (size_t)memCounters.WorkingSetSize;
+#elif defined(LINUX)
+	return read_proc_status("VmRSS:");
 #else
 	return 0;
 #endif
@@ -125,7 +125,8 @@ void FE3FieldElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // create the element's stiffness matrix
         int ndof = 6*el.Nodes();
@@ -139,7 +140,7 @@ void FE3FieldElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
         ElementDilatationalStiffness(fem, iel, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -80,31 +80,25 @@ mat3ds FEContinuousFiberDistribution::Stress(FEMaterialPoint& mp)
     
     double IFD = IntegratedFiberDensity(mp);
 
-	// obtain an integration point iterator
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// get the global fiber direction
-			vec3d& N = it->m_fiber;
+		// get the global fiber direction
+		const vec3d& N = ip.Fiber(i);
 
-			// convert to local coordinates
-			vec3d n0 = Qt*N;
+		// convert to local coordinates
+		vec3d n0 = Qt*N;
 
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			double R = m_pFDD->FiberDensity(mp, n0);
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		double R = m_pFDD->FiberDensity(mp, n0);
             
-			// calculate the stress
-			double wn = it->m_weight;
-			s += m_pFmat->FiberStress(pt, N)*(R*wn);
-		}
-		while (it->Next());
+		// calculate the stress
+		double wn = ip.Weight(i);
+		s += m_pFmat->FiberStress(pt, N)*(R*wn);
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// divide by IFD
 	return s / IFD;
 }
@@ -124,28 +118,23 @@ tens4ds FEContinuousFiberDistribution::Tangent(FEMaterialPoint& mp)
 	tens4ds c;
 	c.zero();
 
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// get the global fiber direction
-			vec3d& N = it->m_fiber;
+		// get the global fiber direction
+		const vec3d& N = ip.Fiber(i);
 
-			// convert to local
-			vec3d n0 = Qt*N;
+		// convert to local
+		vec3d n0 = Qt*N;
 
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			double R = m_pFDD->FiberDensity(mp, n0);
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		double R = m_pFDD->FiberDensity(mp, n0);
             
-			// calculate the tangent
-			c += m_pFmat->FiberTangent(mp, N)*(R*it->m_weight);
-		}
-		while (it->Next());
+		// calculate the tangent
+		c += m_pFmat->FiberTangent(mp, N)*(R*ip.Weight(i));
 	}
-
-	// don't forget to delete the iterator
-	delete it;
     
 	// divide by IFD
 	return c / IFD;
@@ -164,29 +153,24 @@ double FEContinuousFiberDistribution::StrainEnergyDensity(FEMaterialPoint& mp)
     double IFD = IntegratedFiberDensity(mp);
 
 	double sed = 0.0;
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// get fiber direction in global coordinate system
-			vec3d& N = it->m_fiber;
+		// get fiber direction in global coordinate system
+		const vec3d& N = ip.Fiber(i);
 
-			// convert to local coordinates
-			vec3d n0 = Qt*N;
+		// convert to local coordinates
+		vec3d n0 = Qt*N;
 
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			double R = m_pFDD->FiberDensity(mp, n0);
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		double R = m_pFDD->FiberDensity(mp, n0);
             
-			// calculate the stress
-			sed += m_pFmat->FiberStrainEnergyDensity(mp, N)*(R*it->m_weight);
-		}
-		while (it->Next());
+		// calculate the stress
+		sed += m_pFmat->FiberStrainEnergyDensity(mp, N)*(R*ip.Weight(i));
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// divide by IFD
 	return sed / IFD;
 }
@@ -196,28 +180,23 @@ double FEContinuousFiberDistribution::IntegratedFiberDensity(FEMaterialPoint& mp
 	// get the local coordinate systems
 	mat3d QT = GetLocalCS(mp).transpose();
 	double IFD = 0;
-	// NOTE: Pass nullptr to GetIterator to avoid issues with GK rule!
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(nullptr);
-	if (it->IsValid())
+	// NOTE: Pass nullptr to GetIntegrationPoints to avoid issues with GK rule!
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(nullptr, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// set fiber direction in global coordinate system
-			vec3d& n0e = it->m_fiber;
+		// set fiber direction in global coordinate system
+		const vec3d& n0e = ip.Fiber(i);
 
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			vec3d n0a = QT * n0e;
-			double R = m_pFDD->FiberDensity(mp, n0a);
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT * n0e;
+		double R = m_pFDD->FiberDensity(mp, n0a);
 
-			// integrate the fiber distribution
-			IFD += R * it->m_weight;
-
-		} while (it->Next());
+		// integrate the fiber distribution
+		IFD += R * ip.Weight(i);
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// just in case
 	if (IFD == 0.0) IFD = 1.0;
 
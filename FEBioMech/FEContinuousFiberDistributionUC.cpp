@@ -68,28 +68,22 @@ mat3ds FEContinuousFiberDistributionUC::DevStress(FEMaterialPoint& mp)
 
 	double IFD = IntegratedFiberDensity(mp);
 
-	// obtain an integration point iterator
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// set the fiber direction
-			vec3d& n0 = it->m_fiber;
-
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			vec3d n0a = QT*n0;
-			double R = m_pFDD->FiberDensity(mp, n0a);
-
-			// calculate the stress
-			double wn = it->m_weight;
-			s += m_pFmat->DevFiberStress(pt, n0)*(R*wn);
-		}
-		while (it->Next());
-	}
+		// set the fiber direction
+		const vec3d& n0 = ip.Fiber(i);
+
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT*n0;
+		double R = m_pFDD->FiberDensity(mp, n0a);
 
-	// don't forget to delete the iterator
-	delete it;
+		// calculate the stress
+		double wn = ip.Weight(i);
+		s += m_pFmat->DevFiberStress(pt, n0)*(R*wn);
+	}
 
 	// divide by IFD
 	return s / IFD;
@@ -110,26 +104,21 @@ tens4ds FEContinuousFiberDistributionUC::DevTangent(FEMaterialPoint& mp)
 
 	double IFD = IntegratedFiberDensity(pt);
 
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// set fiber direction in global coordinate system
-			vec3d& n0e = it->m_fiber;
-
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			vec3d n0a = QT*n0e;
-			double R = m_pFDD->FiberDensity(mp, n0a);
-
-			// calculate the tangent
-			c += m_pFmat->DevFiberTangent(mp, n0e)*(R*it->m_weight);
-		}
-		while (it->Next());
+		// set fiber direction in global coordinate system
+		const vec3d& n0e = ip.Fiber(i);
+
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT*n0e;
+		double R = m_pFDD->FiberDensity(mp, n0a);
+
+		// calculate the tangent
+		c += m_pFmat->DevFiberTangent(mp, n0e)*(R*ip.Weight(i));
 	}
-	
-	// don't forget to delete the iterator
-	delete it;
 
 	// divide by IFD
 	return c / IFD;
@@ -146,26 +135,21 @@ double FEContinuousFiberDistributionUC::DevStrainEnergyDensity(FEMaterialPoint&
 
 	double IFD = IntegratedFiberDensity(mp);
 	double sed = 0.0;
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&pt);
-	if (it->IsValid())
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(&pt, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// set fiber direction in global coordinate system
-			vec3d& n0e = it->m_fiber;
-
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			vec3d n0a = QT*n0e;
-			double R = m_pFDD->FiberDensity(mp, n0a);
-
-			// calculate the stress
-			sed += m_pFmat->DevFiberStrainEnergyDensity(mp, n0e)*(R*it->m_weight);
-		}
-		while (it->Next());
-	}
+		// set fiber direction in global coordinate system
+		const vec3d& n0e = ip.Fiber(i);
+
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT*n0e;
+		double R = m_pFDD->FiberDensity(mp, n0a);
 
-	// don't forget to delete the iterator
-	delete it;
+		// calculate the stress
+		sed += m_pFmat->DevFiberStrainEnergyDensity(mp, n0e)*(R*ip.Weight(i));
+	}
 
 	// divide by IFD
 	return sed / IFD;
@@ -176,28 +160,23 @@ double FEContinuousFiberDistributionUC::IntegratedFiberDensity(FEMaterialPoint&
 	// get the local coordinate systems
 	mat3d QT = GetLocalCS(mp).transpose();
 	double IFD = 0;
-	// NOTE: Pass nullptr to GetIterator to avoid issues with GK rule!
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(nullptr);
-	if (it->IsValid())
+	// NOTE: Pass nullptr to GetIntegrationPoints to avoid issues with GK rule!
+	// get the integration points (the buffer is reused to avoid allocations)
+	static thread_local FEFiberIntegrationPoints buf;
+	const FEFiberIntegrationPoints& ip = m_pFint->GetIntegrationPoints(nullptr, buf);
+	for (int i = 0; i < ip.Points(); ++i)
 	{
-		do
-		{
-			// set fiber direction in global coordinate system
-			vec3d& n0e = it->m_fiber;
+		// set fiber direction in global coordinate system
+		const vec3d& n0e = ip.Fiber(i);
 
-			// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
-			vec3d n0a = QT * n0e;
-			double R = m_pFDD->FiberDensity(mp, n0a);
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT * n0e;
+		double R = m_pFDD->FiberDensity(mp, n0a);
 
-			// integrate the fiber distribution
-			IFD += R * it->m_weight;
-
-		} while (it->Next());
+		// integrate the fiber distribution
+		IFD += R * ip.Weight(i);
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// just in case
 	if (IFD == 0.0) IFD = 1.0;
 
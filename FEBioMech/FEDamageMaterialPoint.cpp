@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEDamageMaterialPoint.h"
 #include <FECore/DumpStream.h>
+#include <typeinfo>
 
 FEMaterialPoint* FEDamageMaterialPoint::Copy()
 {
@@ -59,3 +60,18 @@ void FEDamageMaterialPoint::Serialize(DumpStream& ar)
 	FEMaterialPoint::Serialize(ar);
 	ar & m_Etrial & m_Emax & m_D;
 }
+
+//-----------------------------------------------------------------------------
+int FEDamageMaterialPoint::StateSize() const
+{
+	// derived classes may have more data, so they need to be serialized
+	return (typeid(*this) == typeid(FEDamageMaterialPoint) ? 3 : -1);
+}
+
+//-----------------------------------------------------------------------------
+void FEDamageMaterialPoint::CopyState(double*& pd, bool bsave)
+{
+	CopyValue(m_Etrial, pd, bsave);
+	CopyValue(m_Emax, pd, bsave);
+	CopyValue(m_D, pd, bsave);
+}
@@ -46,6 +46,9 @@ public:
     void Update(const FETimeInfo& timeInfo);
     
     void Serialize(DumpStream& ar);
+
+	int StateSize() const override;
+	void CopyState(double*& pd, bool bsave) override;
     
 public:
 	double	m_Etrial;		//!< trial damage criterion at time t
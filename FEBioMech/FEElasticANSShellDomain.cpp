@@ -439,7 +439,8 @@ void FEElasticANSShellDomain::StiffnessMatrix(FELinearSystem& LS)
 		FEShellElement& el = m_Elem[iel];
 
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         
@@ -447,7 +448,7 @@ void FEElasticANSShellDomain::StiffnessMatrix(FELinearSystem& LS)
         ElementStiffness(iel, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -467,7 +468,8 @@ void FEElasticANSShellDomain::MassMatrix(FELinearSystem& LS, double scale)
 		FEShellElementNew& el = m_Elem[iel];
 
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         ke.zero();
@@ -476,7 +478,7 @@ void FEElasticANSShellDomain::MassMatrix(FELinearSystem& LS, double scale)
         ElementMassMatrix(el, ke, scale);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -496,7 +498,8 @@ void FEElasticANSShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce
 		FEShellElementNew& el = m_Elem[iel];
         
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         ke.zero();
@@ -505,7 +508,7 @@ void FEElasticANSShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -0,0 +1,104 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "FEElasticMaterialPoint.h"
+#include <FECore/FEModelParam.h>
+
+//-----------------------------------------------------------------------------
+//! The kinematics of a batch of elastic material points, stored as structure-
+//! of-arrays. Materials that implement the batched stress and tangent functions
+//! use this to evaluate the constitutive relations for all points of the batch 
+//! in simple loops that the compiler can vectorize.
+class FEElasticBatch
+{
+public:
+	enum { MAX_POINTS = 16 };
+
+	// component indices of symmetric tensors
+	enum { XX, YY, ZZ, XY, YZ, XZ };
+
+public:
+	//! gather the kinematics of the material points (n <= MAX_POINTS)
+	void Gather(FEMaterialPoint** mp, int n)
+	{
+		m_n = n;
+		for (int i = 0; i < n; ++i)
+		{
+			FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+			const mat3d& F = pt.m_F;
+			m_F[0][i] = F[0][0]; m_F[1][i] = F[0][1]; m_F[2][i] = F[0][2];
+			m_F[3][i] = F[1][0]; m_F[4][i] = F[1][1]; m_F[5][i] = F[1][2];
+			m_F[6][i] = F[2][0]; m_F[7][i] = F[2][1]; m_F[8][i] = F[2][2];
+			m_J[i] = pt.m_J;
+		}
+
+		// left Cauchy-Green tensor b = F*Ft
+		for (int i = 0; i < n; ++i)
+		{
+			m_b[XX][i] = m_F[0][i]*m_F[0][i] + m_F[1][i]*m_F[1][i] + m_F[2][i]*m_F[2][i];
+			m_b[YY][i] = m_F[3][i]*m_F[3][i] + m_F[4][i]*m_F[4][i] + m_F[5][i]*m_F[5][i];
+			m_b[ZZ][i] = m_F[6][i]*m_F[6][i] + m_F[7][i]*m_F[7][i] + m_F[8][i]*m_F[8][i];
+			m_b[XY][i] = m_F[0][i]*m_F[3][i] + m_F[1][i]*m_F[4][i] + m_F[2][i]*m_F[5][i];
+			m_b[YZ][i] = m_F[3][i]*m_F[6][i] + m_F[4][i]*m_F[7][i] + m_F[5][i]*m_F[8][i];
+			m_b[XZ][i] = m_F[0][i]*m_F[6][i] + m_F[1][i]*m_F[7][i] + m_F[2][i]*m_F[8][i];
+		}
+	}
+
+	//! calculate the square of the left Cauchy-Green tensor
+	void LeftCauchyGreenSqr(double b2[6][MAX_POINTS]) const
+	{
+		const double (*b)[MAX_POINTS] = m_b;
+		for (int i = 0; i < m_n; ++i)
+		{
+			b2[XX][i] = b[XX][i]*b[XX][i] + b[XY][i]*b[XY][i] + b[XZ][i]*b[XZ][i];
+			b2[YY][i] = b[XY][i]*b[XY][i] + b[YY][i]*b[YY][i] + b[YZ][i]*b[YZ][i];
+			b2[ZZ][i] = b[XZ][i]*b[XZ][i] + b[YZ][i]*b[YZ][i] + b[ZZ][i]*b[ZZ][i];
+			b2[XY][i] = b[XX][i]*b[XY][i] + b[XY][i]*b[YY][i] + b[XZ][i]*b[YZ][i];
+			b2[YZ][i] = b[XY][i]*b[XZ][i] + b[YY][i]*b[YZ][i] + b[YZ][i]*b[ZZ][i];
+			b2[XZ][i] = b[XX][i]*b[XZ][i] + b[XY][i]*b[YZ][i] + b[XZ][i]*b[ZZ][i];
+		}
+	}
+
+	//! evaluate a material parameter at the material points
+	static void Evaluate(FEParamDouble& p, FEMaterialPoint** mp, int n, double* v)
+	{
+		for (int i = 0; i < n; ++i) v[i] = p(*mp[i]);
+	}
+
+	//! copy symmetric tensors from structure-of-arrays storage
+	static void Store(double s[6][MAX_POINTS], int n, mat3ds* out)
+	{
+		for (int i = 0; i < n; ++i) out[i] = mat3ds(s[XX][i], s[YY][i], s[ZZ][i], s[XY][i], s[YZ][i], s[XZ][i]);
+	}
+
+public:
+	int		m_n;					//!< number of points in batch
+	double	m_J[MAX_POINTS];		//!< Jacobian
+	double	m_F[9][MAX_POINTS];		//!< deformation gradient (row major)
+	double	m_b[6][MAX_POINTS];		//!< left Cauchy-Green tensor
+};
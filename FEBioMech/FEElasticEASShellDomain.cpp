@@ -489,7 +489,8 @@ void FEElasticEASShellDomain::StiffnessMatrix(FELinearSystem& LS)
 		FEShellElement& el = m_Elem[iel];
 
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         
@@ -497,7 +498,7 @@ void FEElasticEASShellDomain::StiffnessMatrix(FELinearSystem& LS)
         ElementStiffness(iel, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -517,7 +518,8 @@ void FEElasticEASShellDomain::MassMatrix(FELinearSystem& LS, double scale)
 		FEShellElementNew& el = m_Elem[iel];
         
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         ke.zero();
@@ -526,7 +528,7 @@ void FEElasticEASShellDomain::MassMatrix(FELinearSystem& LS, double scale)
         ElementMassMatrix(el, ke, scale);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -546,7 +548,8 @@ void FEElasticEASShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce
 		FEShellElementNew& el = m_Elem[iel];
         
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
         ke.resize(ndof, ndof);
         ke.zero();
@@ -555,7 +558,7 @@ void FEElasticEASShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -57,3 +57,42 @@ vec3d FEElasticFiberMaterial::FiberVector(FEMaterialPoint& mp)
 
 	return a0;
 }
+
+//-----------------------------------------------------------------------------
+void FEElasticFiberMaterial::FiberStressBatch(FEMaterialPoint** mp, const vec3d* a0, int n, mat3ds* s)
+{
+	for (int i = 0; i < n; ++i) s[i] = FiberStress(*mp[i], a0[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticFiberMaterial::FiberTangentBatch(FEMaterialPoint** mp, const vec3d* a0, int n, tens4ds* C)
+{
+	for (int i = 0; i < n; ++i) C[i] = FiberTangent(*mp[i], a0[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticFiberMaterial::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	// gather the fiber vectors in chunks
+	const int NMAX = 16;
+	vec3d a0[NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		for (int i = 0; i < m; ++i) a0[i] = FiberVector(*mp[k + i]);
+		FiberStressBatch(mp + k, a0, m, s + k);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticFiberMaterial::TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C)
+{
+	const int NMAX = 16;
+	vec3d a0[NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		for (int i = 0; i < m; ++i) a0[i] = FiberVector(*mp[k + i]);
+		FiberTangentBatch(mp + k, a0, m, C + k);
+	}
+}
@@ -49,6 +49,12 @@ public:
 	//! Strain energy density
 	virtual double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) = 0;
 
+	// calculate stress at n material points with fiber directions a0
+	virtual void FiberStressBatch(FEMaterialPoint** mp, const vec3d* a0, int n, mat3ds* s);
+
+	// spatial tangent at n material points with fiber directions a0
+	virtual void FiberTangentBatch(FEMaterialPoint** mp, const vec3d* a0, int n, tens4ds* C);
+
 private:
 	// These are made private since fiber materials should implement the functions above instead. 
 	// The functions can still be reached when a fiber material is used in an elastic mixture. 
@@ -56,6 +62,8 @@ private:
 	mat3ds Stress(FEMaterialPoint& mp) final { return FiberStress(mp, FiberVector(mp)); }
 	tens4ds Tangent(FEMaterialPoint& mp) final { return FiberTangent(mp, FiberVector(mp)); }
 	double StrainEnergyDensity(FEMaterialPoint& mp) final { return FiberStrainEnergyDensity(mp, FiberVector(mp)); }
+	void StressBatch(FEMaterialPoint** mp, int n, mat3ds* s) final;
+	void TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C) final;
 
 public:
 	FEParamVec3		m_fiber;	//!< fiber orientation
@@ -53,6 +53,16 @@ mat3ds FEElasticMaterial::SolidStress(FEMaterialPoint& pt)
 	return (m_secant_stress ? SecantStress(pt) : Stress(pt));
 }
 
+//-----------------------------------------------------------------------------
+void FEElasticMaterial::SolidStressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	if (m_secant_stress)
+	{
+		for (int i = 0; i < n; ++i) s[i] = SecantStress(*mp[i]);
+	}
+	else StressBatch(mp, n, s);
+}
+
 //-----------------------------------------------------------------------------
 //! calculate spatial tangent stiffness at material point, using secant method
 mat3ds FEElasticMaterial::SecantStress(FEMaterialPoint& mp)
@@ -57,6 +57,8 @@ public:
 
 	mat3ds SolidStress(FEMaterialPoint& pt) override;
 
+	void SolidStressBatch(FEMaterialPoint** mp, int n, mat3ds* s) override;
+
 protected:
 	bool	m_secant_stress;	//!< use secant approximation to stress
 
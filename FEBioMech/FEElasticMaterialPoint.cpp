@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEElasticMaterialPoint.h"
+#include <typeinfo>
 
 //-----------------------------------------------------------------------------
 FEElasticMaterialPoint::FEElasticMaterialPoint()
@@ -73,6 +74,28 @@ void FEElasticMaterialPoint::Serialize(DumpStream& ar)
     ar & m_F & m_J & m_s & m_v & m_a & m_gradJ & m_L & m_Wt & m_Wp;
 }
 
+//-----------------------------------------------------------------------------
+int FEElasticMaterialPoint::StateSize() const
+{
+	// derived classes may have more data, so they need to be serialized
+	if (typeid(*this) != typeid(FEElasticMaterialPoint)) return -1;
+	return (int)((2*sizeof(mat3d) + sizeof(mat3ds) + 3*sizeof(vec3d) + 3*sizeof(double)) / sizeof(double));
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticMaterialPoint::CopyState(double*& pd, bool bsave)
+{
+	CopyValue(m_F, pd, bsave);
+	CopyValue(m_J, pd, bsave);
+	CopyValue(m_s, pd, bsave);
+	CopyValue(m_v, pd, bsave);
+	CopyValue(m_a, pd, bsave);
+	CopyValue(m_gradJ, pd, bsave);
+	CopyValue(m_L, pd, bsave);
+	CopyValue(m_Wt, pd, bsave);
+	CopyValue(m_Wp, pd, bsave);
+}
+
 //-----------------------------------------------------------------------------
 //! Calculates the right Cauchy-Green tensor at the current material point
 
@@ -49,6 +49,9 @@ public:
 	//! serialize material point data
 	void Serialize(DumpStream& ar) override;
 
+	int StateSize() const override;
+	void CopyState(double*& pd, bool bsave) override;
+
 public:
 	mat3ds Strain() const;
 	mat3ds SmallStrain() const;
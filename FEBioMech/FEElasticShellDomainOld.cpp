@@ -528,7 +528,8 @@ void FEElasticShellDomainOld::StiffnessMatrix(FELinearSystem& LS)
 		FEMaterial* pmat = m_pMat;
 
 		// create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = 6*el.Nodes();
 		ke.resize(ndof, ndof);
 
@@ -536,7 +537,7 @@ void FEElasticShellDomainOld::StiffnessMatrix(FELinearSystem& LS)
 		ElementStiffness(iel, ke);
 
 		// get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
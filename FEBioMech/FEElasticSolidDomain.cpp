@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioMech.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FESolidElementKernel.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -192,8 +193,8 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 
 void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
 {
-	// jacobian matrix, inverse jacobian matrix and determinants
-	double Ji[3][3];
+	// spatial derivatives of shape functions
+	vec3d G[FEElement::MAX_NODES];
 
 	int nint = el.GaussPoints();
 	int neln = el.Nodes();
@@ -206,41 +207,16 @@ void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<doubl
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
 
-		// calculate the jacobian
-		double detJt = (m_update_dynamic ? invjact(el, Ji, n, m_alphaf) : invjact(el, Ji, n));
+		// calculate the jacobian and global gradient of shape functions
+		double detJt = (m_update_dynamic ? ShapeGradient(el, n, G, m_alphaf) : ShapeGradient(el, n, G));
 
 		detJt *= gw[n];
 
 		// get the stress vector for this integration point
         const mat3ds& s = pt.m_s;
 
-		const double* Gr = el.Gr(n);
-		const double* Gs = el.Gs(n);
-		const double* Gt = el.Gt(n);
-
-		for (int i=0; i<neln; ++i)
-		{
-			// calculate global gradient of shape functions
-			// note that we need the transposed of Ji, not Ji itself !
-			double Gx = Ji[0][0]*Gr[i]+Ji[1][0]*Gs[i]+Ji[2][0]*Gt[i];
-			double Gy = Ji[0][1]*Gr[i]+Ji[1][1]*Gs[i]+Ji[2][1]*Gt[i];
-			double Gz = Ji[0][2]*Gr[i]+Ji[1][2]*Gs[i]+Ji[2][2]*Gt[i];
-
-			// calculate internal force
-			// the '-' sign is so that the internal forces get subtracted
-			// from the global residual vector
-			fe[3*i  ] -= ( Gx*s.xx() +
-				           Gy*s.xy() +
-					       Gz*s.xz() )*detJt;
-
-			fe[3*i+1] -= ( Gy*s.yy() +
-				           Gx*s.xy() +
-					       Gz*s.yz() )*detJt;
-
-			fe[3*i+2] -= ( Gz*s.zz() +
-				           Gy*s.yz() +
-					       Gx*s.xz() )*detJt;
-		}
+		// calculate internal force
+		FESolidKernel::internalForce(m_kernel, neln, G, s, detJt, &fe[0]);
 	}
 }
 
@@ -300,15 +276,7 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 		// element's Cauchy-stress tensor at gauss point n
 		mat3ds& s = pt.m_s;
 
-		for (int i = 0; i<neln; ++i)
-			for (int j = 0; j<neln; ++j)
-			{
-				double kab = (G[i]*(s * G[j]))*w;
-
-				ke[3*i  ][3*j  ] += kab;
-				ke[3*i+1][3*j+1] += kab;
-				ke[3*i+2][3*j+2] += kab;
-			}
+		FESolidKernel::geometricalStiffness(m_kernel, neln, G, s, w, ke);
 	}
 }
 
@@ -324,89 +292,34 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	// global derivatives of shape functions
 	vec3d G[FEElement::MAX_NODES];
 
-	double Gxi, Gyi, Gzi;
-	double Gxj, Gyj, Gzj;
-
 	// The 'D' matrix
 	double D[6][6] = {0};	// The 'D' matrix
 
-	// The 'D*BL' matrix
-	double DBL[6][3];
-
 	// jacobian
 	double detJt;
 	
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// evaluate the tangents at all material points in one batch
+	// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
+	const int NINT = FEElement::MAX_INTPOINTS;
+	FEMaterialPoint* mps[NINT];
+	tens4dmm C[NINT];
+	for (int n=0; n<nint; ++n) mps[n] = el.GetMaterialPoint(n);
+	m_pMat->SolidTangentBatch(mps, nint, C);
+
 	// calculate element stiffness matrix
 	for (int n=0; n<nint; ++n)
 	{
 		// calculate jacobian and shape function gradients
 		detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
 
-		// setup the material point
-		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
-		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-
 		// get the 'D' matrix
-//		tens4ds C = m_pMat->Tangent(mp);
-        tens4dmm C = m_pMat->SolidTangent(mp);
-		C.extract(D);
-
-		// we only calculate the upper triangular part
-		// since ke is symmetric. The other part is
-		// determined below using this symmetry.
-		for (int i=0, i3=0; i<neln; ++i, i3 += 3)
-		{
-			Gxi = G[i].x;
-			Gyi = G[i].y;
-			Gzi = G[i].z;
+		C[n].extract(D);
 
-			for (int j=0, j3 = 0; j<neln; ++j, j3 += 3)
-			{
-				Gxj = G[j].x;
-				Gyj = G[j].y;
-				Gzj = G[j].z;
-
-				// calculate D*BL matrices
-				DBL[0][0] = (D[0][0]*Gxj+D[0][3]*Gyj+D[0][5]*Gzj);
-				DBL[0][1] = (D[0][1]*Gyj+D[0][3]*Gxj+D[0][4]*Gzj);
-				DBL[0][2] = (D[0][2]*Gzj+D[0][4]*Gyj+D[0][5]*Gxj);
-
-				DBL[1][0] = (D[1][0]*Gxj+D[1][3]*Gyj+D[1][5]*Gzj);
-				DBL[1][1] = (D[1][1]*Gyj+D[1][3]*Gxj+D[1][4]*Gzj);
-				DBL[1][2] = (D[1][2]*Gzj+D[1][4]*Gyj+D[1][5]*Gxj);
-
-				DBL[2][0] = (D[2][0]*Gxj+D[2][3]*Gyj+D[2][5]*Gzj);
-				DBL[2][1] = (D[2][1]*Gyj+D[2][3]*Gxj+D[2][4]*Gzj);
-				DBL[2][2] = (D[2][2]*Gzj+D[2][4]*Gyj+D[2][5]*Gxj);
-
-				DBL[3][0] = (D[3][0]*Gxj+D[3][3]*Gyj+D[3][5]*Gzj);
-				DBL[3][1] = (D[3][1]*Gyj+D[3][3]*Gxj+D[3][4]*Gzj);
-				DBL[3][2] = (D[3][2]*Gzj+D[3][4]*Gyj+D[3][5]*Gxj);
-
-				DBL[4][0] = (D[4][0]*Gxj+D[4][3]*Gyj+D[4][5]*Gzj);
-				DBL[4][1] = (D[4][1]*Gyj+D[4][3]*Gxj+D[4][4]*Gzj);
-				DBL[4][2] = (D[4][2]*Gzj+D[4][4]*Gyj+D[4][5]*Gxj);
-
-				DBL[5][0] = (D[5][0]*Gxj+D[5][3]*Gyj+D[5][5]*Gzj);
-				DBL[5][1] = (D[5][1]*Gyj+D[5][3]*Gxj+D[5][4]*Gzj);
-				DBL[5][2] = (D[5][2]*Gzj+D[5][4]*Gyj+D[5][5]*Gxj);
-
-				ke[i3  ][j3  ] += (Gxi*DBL[0][0] + Gyi*DBL[3][0] + Gzi*DBL[5][0] )*detJt;
-				ke[i3  ][j3+1] += (Gxi*DBL[0][1] + Gyi*DBL[3][1] + Gzi*DBL[5][1] )*detJt;
-				ke[i3  ][j3+2] += (Gxi*DBL[0][2] + Gyi*DBL[3][2] + Gzi*DBL[5][2] )*detJt;
-
-				ke[i3+1][j3  ] += (Gyi*DBL[1][0] + Gxi*DBL[3][0] + Gzi*DBL[4][0] )*detJt;
-				ke[i3+1][j3+1] += (Gyi*DBL[1][1] + Gxi*DBL[3][1] + Gzi*DBL[4][1] )*detJt;
-				ke[i3+1][j3+2] += (Gyi*DBL[1][2] + Gxi*DBL[3][2] + Gzi*DBL[4][2] )*detJt;
-
-				ke[i3+2][j3  ] += (Gzi*DBL[2][0] + Gyi*DBL[4][0] + Gxi*DBL[5][0] )*detJt;
-				ke[i3+2][j3+1] += (Gzi*DBL[2][1] + Gyi*DBL[4][1] + Gxi*DBL[5][1] )*detJt;
-				ke[i3+2][j3+2] += (Gzi*DBL[2][2] + Gyi*DBL[4][2] + Gxi*DBL[5][2] )*detJt;
-			}
-		}
+		// add the material stiffness of this integration point
+		FESolidKernel::materialStiffness(m_kernel, neln, G, D, detJt, ke);
 	}
 }
 
@@ -415,43 +328,65 @@ void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
 	// repeat over all solid elements
 	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
-		FESolidElement& el = m_Elem[iel];
 
-		if (el.isActive()) {
-
-			// get the element's LM vector
-			vector<int> lm;
-			UnpackLM(el, lm);
+	if (LS.ColoredAssembly())
+	{
+		// Elements of the same color share no nodes, so we can assemble 
+		// them concurrently without atomic updates.
+		if (ElementColors() == 0) CreateElementColoring();
 
-			// element stiffness matrix
-			FEElementMatrix ke(el, lm);
+		LS.SetAtomicAssembly(false);
+		for (int c = 0; c < ElementColors(); ++c)
+		{
+			const vector<int>& elemList = ElementColor(c);
+			int NC = (int)elemList.size();
 
-			// create the element's stiffness matrix
-			int ndof = 3 * el.Nodes();
-			ke.resize(ndof, ndof);
-			ke.zero();
-
-			// calculate geometrical stiffness
-			ElementGeometricalStiffness(el, ke);
-
-			// calculate material stiffness
-			ElementMaterialStiffness(el, ke);
-
-/*			// assign symmetic parts
-			// TODO: Can this be omitted by changing the Assemble routine so that it only
-			// grabs elements from the upper diagonal matrix?
-			for (int i = 0; i < ndof; ++i)
-				for (int j = i + 1; j < ndof; ++j)
-					ke[j][i] = ke[i][j];
-*/
-			// assemble element matrix in global stiffness matrix
-			LS.Assemble(ke);
+			#pragma omp parallel for shared (NC)
+			for (int i = 0; i < NC; ++i)
+			{
+				FESolidElement& el = m_Elem[elemList[i]];
+				if (el.isActive()) AssembleElementStiffness(el, LS);
+			}
 		}
+		LS.SetAtomicAssembly(true);
 	}
+	else
+	{
+		#pragma omp parallel for shared (NE)
+		for (int iel = 0; iel < NE; ++iel)
+		{
+			FESolidElement& el = m_Elem[iel];
+			if (el.isActive()) AssembleElementStiffness(el, LS);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! calculate and assemble the stiffness matrix of a single element
+void FEElasticSolidDomain::AssembleElementStiffness(FESolidElement& el, FELinearSystem& LS)
+{
+	// get the element's LM vector
+	static thread_local vector<int> lm;
+	UnpackLM(el, lm);
+
+	// element stiffness matrix
+	// (this is reused for all the elements that are assembled by this thread)
+	static thread_local FEElementMatrix ke;
+	ke.SetElement(el, lm);
+
+	// create the element's stiffness matrix
+	int ndof = 3 * el.Nodes();
+	ke.resize(ndof, ndof);
+	ke.zero();
+
+	// calculate geometrical stiffness
+	ElementGeometricalStiffness(el, ke);
+
+	// calculate material stiffness
+	ElementMaterialStiffness(el, ke);
+
+	// assemble element matrix in global stiffness matrix
+	LS.Assemble(ke);
 }
 
 //-----------------------------------------------------------------------------
@@ -605,35 +540,38 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 		}
 	}
 
-	// loop over the integration points and calculate
-	// the stress at the integration point
+	// loop over the integration points and update the kinematics
+	const int NINT = FEElement::MAX_INTPOINTS;
+	FEMaterialPoint* mps[NINT];
+	double Jt[NINT];
+	mat3d Ft[NINT];
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		mps[n] = &mp;
 
 		// material point coordinates
 		pt.m_rt = el.Evaluate(r, n);
 
 		// get the deformation gradient and determinant at intermediate time
-        double Jt;
-        mat3d Ft, Fp;
-        Jt = defgrad(el, Ft, n);
+        mat3d Fp;
+        Jt[n] = defgrad(el, Ft[n], n);
         defgradp(el, Fp, n);
 
 		if (m_alphaf == 1.0)
 		{
-			pt.m_F = Ft;
-            pt.m_J = Jt;
+			pt.m_F = Ft[n];
+            pt.m_J = Jt[n];
 		}
 		else
 		{
-			pt.m_F = Ft*m_alphaf + Fp*(1-m_alphaf);
+			pt.m_F = Ft[n]*m_alphaf + Fp*(1-m_alphaf);
             pt.m_J = pt.m_F.det();
 		}
 
         mat3d Fi = pt.m_F.inverse();
-        pt.m_L = (Ft - Fp)*Fi / dt;
+        pt.m_L = (Ft[n] - Fp)*Fi / dt;
 		if (m_update_dynamic)
 		{
 			pt.m_v = el.Evaluate(v, n);
@@ -642,18 +580,24 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 
         // update specialized material points
         m_pMat->UpdateSpecializedMaterialPoints(mp, tp);
-        
-		// calculate the stress at this material point
-//		pt.m_s = m_pMat->Stress(mp);
-		pt.m_s = m_pMat->SolidStress(mp);
+	}
+
+	// calculate the stresses at all material points in one batch
+	mat3ds s[NINT];
+	m_pMat->SolidStressBatch(mps, nint, s);
+
+	for (int n=0; n<nint; ++n)
+	{
+		FEElasticMaterialPoint& pt = *(mps[n]->ExtractData<FEElasticMaterialPoint>());
+		pt.m_s = s[n];
         
         // adjust stress for strain energy conservation
         if (m_alphaf == 0.5) 
 		{
 			// evaluate strain energy at current time
 			FEElasticMaterialPoint et = pt;
-			et.m_F = Ft;
-			et.m_J = Jt;
+			et.m_F = Ft[n];
+			et.m_J = Jt[n];
 
 			// evaluate strain-energy density
 			FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
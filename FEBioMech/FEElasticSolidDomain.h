@@ -116,6 +116,10 @@ public:
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
     
+protected:
+	//! calculate and assemble the stiffness matrix of a single element
+	void AssembleElementStiffness(FESolidElement& el, FELinearSystem& LS);
+
 protected:
     double              m_alphaf;
     double              m_alpham;
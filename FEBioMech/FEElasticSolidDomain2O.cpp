@@ -1022,7 +1022,8 @@ void FEElasticSolidDomain2O::StiffnessMatrix(FELinearSystem& LS)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		
 		// create the element's stiffness matrix
 		int ndof = 3*el.Nodes();
@@ -1033,7 +1034,7 @@ void FEElasticSolidDomain2O::StiffnessMatrix(FELinearSystem& LS)
 		ElementStiffness(tp, iel, ke);
 
 		// get the element's LM vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
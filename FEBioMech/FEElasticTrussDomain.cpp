@@ -121,7 +121,8 @@ void FEElasticTrussDomain::StiffnessMatrix(FELinearSystem& LS)
 	for (int iel =0; iel<NT; ++iel)
 	{
 		FETrussElement& el = m_Elem[iel];
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		ElementStiffness(iel, ke);
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEFiberExpPow.h"
+#include "FEElasticBatch.h"
 #include <limits>
 #include <FECore/log.h>
 
@@ -104,6 +105,64 @@ mat3ds FEFiberExpPow::FiberStress(FEMaterialPoint& mp, const vec3d& n0)
 	return s;
 }
 
+//-----------------------------------------------------------------------------
+void FEFiberExpPow::FiberStressBatch(FEMaterialPoint** mp, const vec3d* a0, int n, mat3ds* s)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	FEElasticBatch B;
+	double ksi[NMAX], mu[NMAX], nt[3][NMAX], S[6][NMAX];
+	const double eps = m_epsf* std::numeric_limits<double>::epsilon();
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		B.Gather(mp + k, m);
+		FEElasticBatch::Evaluate(m_ksi, mp + k, m, ksi);
+		FEElasticBatch::Evaluate(m_mu , mp + k, m, mu);
+		const double (*F)[NMAX] = B.m_F;
+		const double (*b)[NMAX] = B.m_b;
+		const vec3d* n0 = a0 + k;
+
+		// spatial fiber direction nt = F*n0
+		for (int i = 0; i < m; ++i)
+		{
+			nt[0][i] = F[0][i]*n0[i].x + F[1][i]*n0[i].y + F[2][i]*n0[i].z;
+			nt[1][i] = F[3][i]*n0[i].x + F[4][i]*n0[i].y + F[5][i]*n0[i].z;
+			nt[2][i] = F[6][i]*n0[i].x + F[7][i]*n0[i].y + F[8][i]*n0[i].z;
+		}
+
+		for (int i = 0; i < m; ++i)
+		{
+			double x = nt[0][i], y = nt[1][i], z = nt[2][i];
+
+			// In - 1 = n0*C*n0 - 1 = nt*nt - 1
+			double In_1 = x*x + y*y + z*z - 1.0;
+
+			// only take fibers in tension into consideration
+			double on = (In_1 >= eps ? 1.0 : 0.0);
+			double In = (In_1 >= eps ? In_1 : 1.0);
+
+			// strain energy derivative
+			double Wl = ksi[i]*pow(In, m_beta-1.0)*exp(m_alpha*pow(In, m_beta));
+			double a = on*2.0*Wl / B.m_J[i];
+			double c = on*mu[i] / B.m_J[i];
+
+			// w = b*nt for the shear term (N*(b - I)).sym()
+			double wx = b[0][i]*x + b[3][i]*y + b[5][i]*z;
+			double wy = b[3][i]*x + b[1][i]*y + b[4][i]*z;
+			double wz = b[5][i]*x + b[4][i]*y + b[2][i]*z;
+
+			S[0][i] = a*x*x + c*(x*wx - x*x);
+			S[1][i] = a*y*y + c*(y*wy - y*y);
+			S[2][i] = a*z*z + c*(z*wz - z*z);
+			S[3][i] = a*x*y + c*(0.5*(x*wy + wx*y) - x*y);
+			S[4][i] = a*y*z + c*(0.5*(y*wz + wy*z) - y*z);
+			S[5][i] = a*x*z + c*(0.5*(x*wz + wx*z) - x*z);
+		}
+
+		FEElasticBatch::Store(S, m, s + k);
+	}
+}
+
 //-----------------------------------------------------------------------------
 tens4ds FEFiberExpPow::FiberTangent(FEMaterialPoint& mp, const vec3d& n0)
 {
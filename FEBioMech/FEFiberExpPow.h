@@ -43,6 +43,9 @@ public:
 	
 	// Spatial tangent
 	tens4ds FiberTangent(FEMaterialPoint& mp, const vec3d& a0) override;
+
+	//! Cauchy stress at n material points
+	void FiberStressBatch(FEMaterialPoint** mp, const vec3d* a0, int n, mat3ds* s) override;
 	
 	//! Strain energy density
 	double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) override;
@@ -268,6 +268,10 @@ bool FEFiberIntegrationGauss::InitRule()
             break;
     }
 
+	// the integration points without a material point can be evaluated once
+	Iterator it(nullptr, m_rule);
+	FillIntegrationPoints(it, m_pts0);
+
 	return true;
 }
 
@@ -296,3 +300,14 @@ FEFiberIntegrationSchemeIterator* FEFiberIntegrationGauss::GetIterator(FEMateria
 {
 	return new Iterator(mp, m_rule);
 }
+
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationGauss::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	// without a material point, the integration points do not change
+	if (mp == nullptr) return m_pts0;
+
+	Iterator it(mp, m_rule);
+	FillIntegrationPoints(it, pts);
+	return pts;
+}
@@ -57,12 +57,17 @@ public:
 	// get iterator
 	virtual FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
 
+	// get the integration points
+	const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts) override;
+
 protected:
 	bool InitRule();
     
 protected:	// parameters
 	GRULE	m_rule;
 
+	FEFiberIntegrationPoints	m_pts0;	// integration points in the reference configuration
+
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
 };
@@ -269,6 +269,10 @@ bool FEFiberIntegrationGaussKronrod::InitRule()
 		break;
 	}
 
+	// the integration points without a material point can be evaluated once
+	Iterator it(nullptr, m_rule);
+	FillIntegrationPoints(it, m_pts0);
+
 	return true;
 }
 
@@ -278,3 +282,14 @@ FEFiberIntegrationSchemeIterator* FEFiberIntegrationGaussKronrod::GetIterator(FE
 	// create a new iterator
 	return new Iterator(mp, m_rule);
 }
+
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationGaussKronrod::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	// without a material point, the integration points do not change
+	if (mp == nullptr) return m_pts0;
+
+	Iterator it(mp, m_rule);
+	FillIntegrationPoints(it, pts);
+	return pts;
+}
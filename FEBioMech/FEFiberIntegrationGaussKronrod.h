@@ -58,11 +58,16 @@ public:
 	// get the iterator
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
 
+	// get the integration points
+	const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts) override;
+
 protected:
 	bool InitRule();
     
 protected: // parameters
 	GKRULE	m_rule;
+
+	FEFiberIntegrationPoints	m_pts0;	// integration points in the reference configuration
     
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
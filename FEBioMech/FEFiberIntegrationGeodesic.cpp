@@ -144,6 +144,10 @@ void FEFiberIntegrationGeodesic::InitIntegrationRule()
 		m_sph[n] = sin(phi[n]);
 		m_w[n] = w[n];
 	}
+
+	// store the integration points so they can be used without an iterator
+	Iterator it(m_nint, &m_cth[0], &m_cph[0], &m_sth[0], &m_sph[0], &m_w[0]);
+	FillIntegrationPoints(it, m_pts);
 }
 
 //-----------------------------------------------------------------------------
@@ -151,3 +155,10 @@ FEFiberIntegrationSchemeIterator* FEFiberIntegrationGeodesic::GetIterator(FEMate
 {
 	return new Iterator(m_nint, &m_cth[0], &m_cph[0], &m_sth[0], &m_sph[0], &m_w[0]);
 }
+
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationGeodesic::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	// the integration points don't depend on the material point
+	return m_pts;
+}
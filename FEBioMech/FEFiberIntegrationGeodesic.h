@@ -50,6 +50,9 @@ public:
 	// get iterator
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
 
+	// get the integration points
+	const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts) override;
+
 protected:
 	void InitIntegrationRule();  
 
@@ -64,6 +67,8 @@ protected:
 	double          m_sph[NSTH];
 	double          m_w[NSTH];
 
+	FEFiberIntegrationPoints	m_pts;	// precomputed integration points
+
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
 };
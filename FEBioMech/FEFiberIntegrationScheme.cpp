@@ -32,3 +32,26 @@ SOFTWARE.*/
 FEFiberIntegrationScheme::FEFiberIntegrationScheme(FEModel* pfem) : FEMaterial(pfem)
 {
 }
+
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationScheme::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	FEFiberIntegrationSchemeIterator* it = GetIterator(mp);
+	FillIntegrationPoints(*it, pts);
+	delete it;
+	return pts;
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationScheme::FillIntegrationPoints(FEFiberIntegrationSchemeIterator& it, FEFiberIntegrationPoints& pts)
+{
+	pts.Clear();
+	if (it.IsValid())
+	{
+		do
+		{
+			pts.Add(it.m_fiber, it.m_weight);
+		}
+		while (it.Next());
+	}
+}
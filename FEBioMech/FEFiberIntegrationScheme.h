@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEElasticMaterial.h"
 #include "FEElasticFiberMaterial.h"
 #include "FEFiberDensityDistribution.h"
+#include <vector>
 
 //----------------------------------------------------------------------------------
 // This is an iterator class that can be used to loop over all integration points of
@@ -54,6 +55,49 @@ public:
 	double	m_weight;		// current integration weight
 };
 
+//----------------------------------------------------------------------------------
+// This class stores the integration points (fiber vectors and weights) of a fiber
+// integration scheme. The storage is reused between calls, so once it has grown to 
+// the size of the scheme, filling it no longer allocates memory.
+class FEFiberIntegrationPoints
+{
+public:
+	FEFiberIntegrationPoints() : m_n(0) {}
+
+	// remove all points (but keep the storage)
+	void Clear() { m_n = 0; }
+
+	// add an integration point
+	void Add(const vec3d& fiber, double weight)
+	{
+		if (m_n == (int)m_fiber.size())
+		{
+			m_fiber.push_back(fiber);
+			m_weight.push_back(weight);
+		}
+		else
+		{
+			m_fiber[m_n] = fiber;
+			m_weight[m_n] = weight;
+		}
+		m_n++;
+	}
+
+	// number of integration points
+	int Points() const { return m_n; }
+
+	// fiber vector of integration point i
+	const vec3d& Fiber(int i) const { return m_fiber[i]; }
+
+	// weight of integration point i
+	double Weight(int i) const { return m_weight[i]; }
+
+private:
+	int					m_n;
+	std::vector<vec3d>	m_fiber;
+	std::vector<double>	m_weight;
+};
+
 //----------------------------------------------------------------------------------
 // Base clase for integration schemes for continuous fiber distributions.
 // The purpose of this class is mainly to provide an interface to the integration schemes
@@ -69,4 +113,15 @@ public:
 	// In general, the integration scheme may depend on the material point.
 	// The passed material point pointer will be zero when evaluating the integrated fiber density
 	virtual FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp = 0) = 0;
+
+	// Returns the integration points of the scheme without allocating an iterator.
+	// Schemes whose integration points do not depend on the material point can return
+	// a precomputed table. Otherwise, the points are stored in the buffer pts, which 
+	// the caller should reuse between calls. The default implementation fills the buffer
+	// using the iterator returned by GetIterator.
+	virtual const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts);
+
+protected:
+	// helper function for filling the integration points from an iterator
+	static void FillIntegrationPoints(FEFiberIntegrationSchemeIterator& it, FEFiberIntegrationPoints& pts);
 };
@@ -106,6 +106,33 @@ FEFiberIntegrationSchemeIterator* FEFiberIntegrationTrapezoidal::GetIterator(FEM
 	return new Iterator(mp, m_nth);
 }
 
+//-----------------------------------------------------------------------------
+bool FEFiberIntegrationTrapezoidal::Init()
+{
+	// the integration points don't depend on the material point, so evaluate them once
+	Iterator it(nullptr, m_nth);
+	FillIntegrationPoints(it, m_pts);
+
+	return FEFiberIntegrationScheme::Init();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationTrapezoidal::Serialize(DumpStream& ar)
+{
+	FEFiberIntegrationScheme::Serialize(ar);
+	if ((ar.IsSaving() == false) && (ar.IsShallow() == false))
+	{
+		Iterator it(nullptr, m_nth);
+		FillIntegrationPoints(it, m_pts);
+	}
+}
+
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationTrapezoidal::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	return m_pts;
+}
+
 /*
 //-----------------------------------------------------------------------------
 mat3ds FEFiberIntegrationTrapezoidal::Stress(FEMaterialPoint& mp)
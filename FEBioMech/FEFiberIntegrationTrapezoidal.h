@@ -40,12 +40,23 @@ public:
     FEFiberIntegrationTrapezoidal(FEModel* pfem);
     ~FEFiberIntegrationTrapezoidal();
 
+	//! Initialization
+	bool Init() override;
+
+	// serialization
+	void Serialize(DumpStream& ar) override;
+
 	// get iterator	
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
+
+	// get the integration points
+	const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts) override;
     
 private:
     int             m_nth;  // number of trapezoidal integration points along theta
 
+	FEFiberIntegrationPoints	m_pts;	// precomputed integration points
+
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
 };
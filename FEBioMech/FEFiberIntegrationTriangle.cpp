@@ -90,6 +90,7 @@ END_FECORE_CLASS();
 FEFiberIntegrationTriangle::FEFiberIntegrationTriangle(FEModel* pfem) : FEFiberIntegrationScheme(pfem)
 { 
 	m_nres = 0; 
+	m_nint = 0;
 }
 
 FEFiberIntegrationTriangle::~FEFiberIntegrationTriangle()
@@ -358,6 +359,10 @@ void FEFiberIntegrationTriangle::InitIntegrationRule()
             }
             break;
     }
+
+	// store the integration points so they can be used without an iterator
+	Iterator it(m_nint, &m_cth[0], &m_cph[0], &m_sth[0], &m_sph[0], &m_w[0]);
+	FillIntegrationPoints(it, m_pts);
 }
 
 //-----------------------------------------------------------------------------
@@ -366,6 +371,13 @@ FEFiberIntegrationSchemeIterator* FEFiberIntegrationTriangle::GetIterator(FEMate
 	return new Iterator(m_nint, &m_cth[0], &m_cph[0], &m_sth[0], &m_sph[0], &m_w[0]);
 }
 
+//-----------------------------------------------------------------------------
+const FEFiberIntegrationPoints& FEFiberIntegrationTriangle::GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts)
+{
+	// the integration points don't depend on the material point
+	return m_pts;
+}
+
 /*
 //-----------------------------------------------------------------------------
 mat3ds FEFiberIntegrationTriangle::Stress(FEMaterialPoint& mp)
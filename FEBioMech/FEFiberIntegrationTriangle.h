@@ -49,6 +49,9 @@ public:
 	// create iterator
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
 
+	// get the integration points
+	const FEFiberIntegrationPoints& GetIntegrationPoints(FEMaterialPoint* mp, FEFiberIntegrationPoints& pts) override;
+
 protected:
 	void InitIntegrationRule();
     
@@ -62,6 +65,8 @@ protected:
 	double          m_cph[2000];
 	double          m_sph[2000];
 	double          m_w[2000];
+
+	FEFiberIntegrationPoints	m_pts;	// precomputed integration points
     
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
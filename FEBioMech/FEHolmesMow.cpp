@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEHolmesMow.h"
+#include "FEElasticBatch.h"
 
 //-----------------------------------------------------------------------------
 // define the material parameters
@@ -77,6 +78,45 @@ mat3ds FEHolmesMow::Stress(FEMaterialPoint& mp)
 	return s;
 }
 
+//-----------------------------------------------------------------------------
+void FEHolmesMow::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	FEElasticBatch B;
+	double b2[6][NMAX], S[6][NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		B.Gather(mp + k, m);
+		B.LeftCauchyGreenSqr(b2);
+		const double (*b)[NMAX] = B.m_b;
+
+		for (int i = 0; i < m; ++i)
+		{
+			// invariants of B
+			double I1 = b[0][i] + b[1][i] + b[2][i];
+			double I2 = (I1*I1 - (b2[0][i] + b2[1][i] + b2[2][i]))/2.;
+			double I3 = b[0][i]*(b[1][i]*b[2][i] - b[4][i]*b[4][i])
+					  - b[3][i]*(b[3][i]*b[2][i] - b[4][i]*b[5][i])
+					  + b[5][i]*(b[3][i]*b[4][i] - b[1][i]*b[5][i]);
+
+			// exponential term
+			double eQ = exp(m_b*((2*mu-lam)*(I1-3) + lam*(I2-3))/Ha)/pow(I3,m_b);
+
+			// s = 0.5/J*eQ*((2*mu+lam*(I1-1))*b - lam*b2 - Ha*I)
+			double c = 0.5*eQ/B.m_J[i];
+			double cb = c*(2*mu+lam*(I1-1));
+			double cb2 = c*lam;
+			for (int j = 0; j < 6; ++j) S[j][i] = cb*b[j][i] - cb2*b2[j][i];
+			S[0][i] -= c*Ha;
+			S[1][i] -= c*Ha;
+			S[2][i] -= c*Ha;
+		}
+
+		FEElasticBatch::Store(S, m, s + k);
+	}
+}
+
 //-----------------------------------------------------------------------------
 tens4ds FEHolmesMow::Tangent(FEMaterialPoint& mp)
 {
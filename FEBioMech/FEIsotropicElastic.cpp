@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEIsotropicElastic.h"
+#include "FEElasticBatch.h"
 
 //-----------------------------------------------------------------------------
 // define the material parameters
@@ -67,6 +68,36 @@ mat3ds FEIsotropicElastic::Stress(FEMaterialPoint& mp)
 	return s;
 }
 
+//-----------------------------------------------------------------------------
+void FEIsotropicElastic::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	FEElasticBatch B;
+	double E[NMAX], v[NMAX], b2[6][NMAX], S[6][NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		B.Gather(mp + k, m);
+		B.LeftCauchyGreenSqr(b2);
+		FEElasticBatch::Evaluate(m_E, mp + k, m, E);
+		FEElasticBatch::Evaluate(m_v, mp + k, m, v);
+
+		for (int i = 0; i < m; ++i)
+		{
+			double Ji = 1.0 / B.m_J[i];
+			double lam = Ji*(v[i]*E[i]/((1+v[i])*(1-2*v[i])));
+			double mu  = Ji*(0.5*E[i]/(1+v[i]));
+			double trE = 0.5*(B.m_b[0][i] + B.m_b[1][i] + B.m_b[2][i] - 3);
+			double a = lam*trE - mu;
+
+			// s = b*(lam*trE - mu) + b2*mu
+			for (int j = 0; j < 6; ++j) S[j][i] = B.m_b[j][i]*a + b2[j][i]*mu;
+		}
+
+		FEElasticBatch::Store(S, m, s + k);
+	}
+}
+
 //-----------------------------------------------------------------------------
 tens4ds FEIsotropicElastic::Tangent(FEMaterialPoint& mp)
 {
@@ -46,6 +46,9 @@ public:
 	//! calculate tangent stiffness at material point
 	virtual tens4ds Tangent(FEMaterialPoint& pt) override;
 
+	//! calculate stress at n material points
+	void StressBatch(FEMaterialPoint** mp, int n, mat3ds* s) override;
+
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
     
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEMooneyRivlin.h"
+#include "FEElasticBatch.h"
 
 //-----------------------------------------------------------------------------
 // define the material parameters
@@ -76,6 +77,52 @@ mat3ds FEMooneyRivlin::DevStress(FEMaterialPoint& mp)
 	return T.dev()*(2.0/J);
 }
 
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric stress of several material points
+void FEMooneyRivlin::DevStressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	FEElasticBatch B;
+	double c1[NMAX], c2[NMAX], b2[6][NMAX], S[6][NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		B.Gather(mp + k, m);
+		B.LeftCauchyGreenSqr(b2);
+		FEElasticBatch::Evaluate(m_c1, mp + k, m, c1);
+		FEElasticBatch::Evaluate(m_c2, mp + k, m, c2);
+		const double (*b)[NMAX] = B.m_b;
+
+		for (int i = 0; i < m; ++i)
+		{
+			double J = B.m_J[i];
+
+			// the deviatoric left Cauchy-Green tensor is B = J^(-2/3)*b
+			double Jm23 = pow(J, -2.0/3.0);
+			double Jm43 = Jm23*Jm23;
+
+			// invariants of B
+			double I1 = Jm23*(b[0][i] + b[1][i] + b[2][i]);
+			double I2 = 0.5*(I1*I1 - Jm43*(b2[0][i] + b2[1][i] + b2[2][i]));
+
+			// W = C1*(I1 - 3) + C2*(I2 - 3)
+			double W1 = c1[i];
+			double W2 = c2[i];
+
+			// T = B*(W1 + W2*I1) - B2*W2
+			double T[6];
+			for (int j = 0; j < 6; ++j) T[j] = Jm23*(W1 + W2*I1)*b[j][i] - Jm43*W2*b2[j][i];
+
+			// s = dev(T)*2/J
+			double trT = (T[0] + T[1] + T[2])/3.0;
+			T[0] -= trT; T[1] -= trT; T[2] -= trT;
+			for (int j = 0; j < 6; ++j) S[j][i] = T[j]*(2.0/J);
+		}
+
+		FEElasticBatch::Store(S, m, s + k);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Calculate the deviatoric tangent
 tens4ds FEMooneyRivlin::DevTangent(FEMaterialPoint& mp)
@@ -49,6 +49,9 @@ public:
 	//! calculate deviatoric tangent stiffness at material point
 	tens4ds DevTangent(FEMaterialPoint& pt) override;
 
+	//! calculate deviatoric stress at n material points
+	void DevStressBatch(FEMaterialPoint** mp, int n, mat3ds* s) override;
+
 	//! calculate deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& mp) override;
     
@@ -32,6 +32,32 @@ SOFTWARE.*/
 #include "FECore/log.h"
 #include <FECore/FEMesh.h>
 
+//-----------------------------------------------------------------------------
+void FEMortarWeights::add(int i, int j, double v)
+{
+	vector<ENTRY>& r = m_row[i];
+	vector<ENTRY>::iterator it = r.begin();
+	while ((it != r.end()) && (it->col < j)) ++it;
+	if ((it != r.end()) && (it->col == j)) it->val += v;
+	else
+	{
+		ENTRY e = {j, v};
+		r.insert(it, e);
+	}
+}
+
+//-----------------------------------------------------------------------------
+double FEMortarWeights::operator () (int i, int j) const
+{
+	const vector<ENTRY>& r = m_row[i];
+	for (size_t n=0; n<r.size(); ++n)
+	{
+		if (r[n].col == j) return r[n].val;
+		if (r[n].col > j) break;
+	}
+	return 0.0;
+}
+
 //-----------------------------------------------------------------------------
 FEMortarInterface::FEMortarInterface(FEModel* pfem) : FEContactInterface(pfem)
 {
@@ -48,10 +74,6 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 	m_n1.resize(NS,NS);
 	m_n2.resize(NS,NM);
 
-	// clear weights
-	m_n1.zero();
-	m_n2.zero();
-
 	// number of integration points
 	const int MAX_INT = 11;
 	const int nint = m_pT->m_nint;
@@ -63,95 +85,125 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 	MortarSurface mortar;
 	CalculateMortarSurface(ss, ms, mortar);
 
-	// These arrays will store the shape function values of the projection points 
-	// on the primary and secondary side when evaluating the integral over a pallet
-	double Ns[MAX_INT][4], Nm[MAX_INT][4];
-
-	// loop over the mortar patches
+	// The contributions of each patch are evaluated in parallel and stored
+	// in these buffers. They are then assembled in patch order, so that the
+	// weights do not depend on the number of threads. Each patch only stores
+	// the ns x ns and ns x nm weights of its two facets.
+	const int MN = FEElement::MAX_NODES;
 	int NP = mortar.Patches();
+	vector<size_t> off1(NP + 1, 0), off2(NP + 1, 0);
 	for (int i=0; i<NP; ++i)
 	{
-		// get the next patch
 		Patch& pi = mortar.GetPatch(i);
+		int ns = ss.Element(pi.GetPrimaryFacetID()).Nodes();
+		int nm = ms.Element(pi.GetSecondaryFacetID()).Nodes();
+		off1[i+1] = off1[i] + ns*ns;
+		off2[i+1] = off2[i] + ns*nm;
+	}
+	vector<double> w1(off1[NP], 0.0), w2(off2[NP], 0.0);
 
-		// get the facet ID's that generated this patch
-		int k = pi.GetPrimaryFacetID();
-		int l = pi.GetSecondaryFacetID();
-
-		// get the non-mortar surface element
-		FESurfaceElement& se = ss.Element(k);
-		// get the mortar surface element
-		FESurfaceElement& me = ms.Element(l);
+#pragma omp parallel
+	{
+		// These arrays will store the shape function values of the projection points 
+		// on the primary and secondary side when evaluating the integral over a pallet
+		double Ns[MAX_INT][MN], Nm[MAX_INT][MN];
 
-		// loop over all patch triangles
-		int np = pi.Size();
-		for (int j=0; j<np; ++j)
+#pragma omp for schedule(dynamic, 16)
+		for (int i=0; i<NP; ++i)
 		{
-			// get the next facet
-			Patch::FACET& fj = pi.Facet(j);
-
-			// calculate the patch area
-			// (We multiply by two because the sum of the integration weights in FEBio sum up to the area
-			// of the triangle in natural coordinates (=0.5)).
-			double Area = fj.Area()*2.0;
-			if (Area > 1e-15)
+			// get the next patch
+			Patch& pi = mortar.GetPatch(i);
+
+			// get the facet ID's that generated this patch
+			int k = pi.GetPrimaryFacetID();
+			int l = pi.GetSecondaryFacetID();
+
+			// get the non-mortar surface element
+			FESurfaceElement& se = ss.Element(k);
+			// get the mortar surface element
+			FESurfaceElement& me = ms.Element(l);
+			int ns = se.Nodes();
+			int nm = me.Nodes();
+
+			double* n1 = &w1[off1[i]];
+			double* n2 = &w2[off2[i]];
+
+			// loop over all patch triangles
+			int np = pi.Size();
+			for (int j=0; j<np; ++j)
 			{
-				// loop over integration points
-				for (int n=0; n<nint; ++n)
+				// get the next facet
+				Patch::FACET& fj = pi.Facet(j);
+
+				// calculate the patch area
+				// (We multiply by two because the sum of the integration weights in FEBio sum up to the area
+				// of the triangle in natural coordinates (=0.5)).
+				double Area = fj.Area()*2.0;
+				if (Area > 1e-15)
 				{
-					// evaluate the spatial position of the integration point on the patch
-					vec3d xp = fj.Position(gr[n], gs[n]);
-
-					// evaluate the integration points on the primary and secondary surfaces
-					// i.e. determine rs, rm
-					double r1 = 0, s1 = 0, r2 = 0, s2 = 0;
-					vec3d xs = ss.ProjectToSurface(se, xp, r1, s1);
-					vec3d xm = ms.ProjectToSurface(me, xp, r2, s2);
-
-//					assert((r1>=0.0)&&(s1>=0)&&(r1+s1<1.0));
-//					assert((r2>=0.0)&&(s2>=0)&&(r2+s2<1.0));
-
-					// evaluate shape functions
-					se.shape_fnc(Ns[n], r1, s1);
-					me.shape_fnc(Nm[n], r2, s2);
-				}
-
-				// Evaluate the contributions to the integrals
-				int ns = se.Nodes();
-				int nm = me.Nodes();
-				for (int A=0; A<ns; ++A)
-				{
-					int a = se.m_lnode[A];
-
-					// loop over all the nodes on the primary facet
-					for (int B=0; B<ns; ++B)
+					// loop over integration points
+					for (int n=0; n<nint; ++n)
 					{
-						double n1 = 0;
-						for (int n=0; n<nint; ++n)
-						{
-							n1 += gw[n]*Ns[n][A]*Ns[n][B];
-						}
-						n1 *= Area;
-
-						int b = se.m_lnode[B];
-						m_n1[a][b] += n1;
+						// evaluate the spatial position of the integration point on the patch
+						vec3d xp = fj.Position(gr[n], gs[n]);
+
+						// evaluate the integration points on the primary and secondary surfaces
+						// i.e. determine rs, rm
+						double r1 = 0, s1 = 0, r2 = 0, s2 = 0;
+						vec3d xs = ss.ProjectToSurface(se, xp, r1, s1);
+						vec3d xm = ms.ProjectToSurface(me, xp, r2, s2);
+
+						// evaluate shape functions
+						se.shape_fnc(Ns[n], r1, s1);
+						me.shape_fnc(Nm[n], r2, s2);
 					}
 
-					// loop over all the nodes on the secondary facet
-					for (int C = 0; C<nm; ++C)
+					// Evaluate the contributions to the integrals
+					for (int A=0; A<ns; ++A)
 					{
-						double n2 = 0;
-						for (int n=0; n<nint; ++n)
+						// loop over all the nodes on the primary facet
+						for (int B=0; B<ns; ++B)
 						{
-							n2 += gw[n]*Ns[n][A]*Nm[n][C];
+							double nAB = 0;
+							for (int n=0; n<nint; ++n)
+							{
+								nAB += gw[n]*Ns[n][A]*Ns[n][B];
+							}
+							n1[A*ns + B] += nAB*Area;
 						}
-						n2 *= Area;
 
-						int c = me.m_lnode[C];
-						m_n2[a][c] += n2;
+						// loop over all the nodes on the secondary facet
+						for (int C = 0; C<nm; ++C)
+						{
+							double nAC = 0;
+							for (int n=0; n<nint; ++n)
+							{
+								nAC += gw[n]*Ns[n][A]*Nm[n][C];
+							}
+							n2[A*nm + C] += nAC*Area;
+						}
 					}
 				}
-			}		
+			}
+		}
+	}
+
+	// assemble the weights
+	for (int i=0; i<NP; ++i)
+	{
+		Patch& pi = mortar.GetPatch(i);
+		FESurfaceElement& se = ss.Element(pi.GetPrimaryFacetID());
+		FESurfaceElement& me = ms.Element(pi.GetSecondaryFacetID());
+		int ns = se.Nodes();
+		int nm = me.Nodes();
+
+		const double* n1 = &w1[off1[i]];
+		const double* n2 = &w2[off2[i]];
+		for (int A=0; A<ns; ++A)
+		{
+			int a = se.m_lnode[A];
+			for (int B=0; B<ns; ++B) m_n1.add(a, se.m_lnode[B], n1[A*ns + B]);
+			for (int C=0; C<nm; ++C) m_n2.add(a, me.m_lnode[C], n2[A*nm + C]);
 		}
 	}
 
@@ -160,11 +212,17 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 	// This is for a hardcoded problem. Remove or generalize this!
 	double sum1 = 0.0;
 	for (int A=0; A<NS; ++A)
-		for (int B=0; B<NS; ++B) sum1 += m_n1[A][B];
+	{
+		const vector<FEMortarWeights::ENTRY>& r = m_n1.row(A);
+		for (size_t n=0; n<r.size(); ++n) sum1 += r[n].val;
+	}
 
 	double sum2 = 0.0;
 	for (int A=0; A<NS; ++A)
-		for (int C=0; C<NM; ++C) sum2 += m_n2[A][C];
+	{
+		const vector<FEMortarWeights::ENTRY>& r = m_n2.row(A);
+		for (size_t n=0; n<r.size(); ++n) sum2 += r[n].val;
+	}
 
 	if (fabs(sum1 - 1.0) > 1e-5) feLog("WARNING: Mortar weights are not correct (%lg).\n", sum1);
 	if (fabs(sum2 - 1.0) > 1e-5) feLog("WARNING: Mortar weights are not correct (%lg).\n", sum2);
@@ -180,26 +238,27 @@ void FEMortarInterface::UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarCont
 	zero(ss.m_gap);
 
 	int NS = ss.Nodes();
-	int NM = ms.Nodes();
 
 	// loop over all primary nodes
 	for (int A=0; A<NS; ++A)
 	{
 		// loop over all primary nodes
-		for (int B=0; B<NS; ++B)
+		const vector<FEMortarWeights::ENTRY>& n1 = m_n1.row(A);
+		for (size_t i=0; i<n1.size(); ++i)
 		{
-			FENode& nodeB = ss.Node(B);
+			FENode& nodeB = ss.Node(n1[i].col);
 			vec3d& xB = nodeB.m_rt;
-			double nAB = m_n1[A][B];
+			double nAB = n1[i].val;
 			gap[A] += xB*nAB;
 		}
 
 		// loop over secondary side
-		for (int C=0; C<NM; ++C)
+		const vector<FEMortarWeights::ENTRY>& n2 = m_n2.row(A);
+		for (size_t i=0; i<n2.size(); ++i)
 		{
-			FENode& nodeC = ms.Node(C);
+			FENode& nodeC = ms.Node(n2[i].col);
 			vec3d& xC = nodeC.m_rt;
-			double nAC = m_n2[A][C];
+			double nAC = n2[i].val;
 			gap[A] -= xC*nAC;
 		}
 	}
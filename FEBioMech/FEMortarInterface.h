@@ -30,6 +30,44 @@ SOFTWARE.*/
 #include "FEContactInterface.h"
 #include "FEMortarContactSurface.h"
 
+//-----------------------------------------------------------------------------
+// Sparse storage for the mortar integration weights. Only the nonzero weights
+// are stored, row by row, with the column indices in ascending order.
+class FEMortarWeights
+{
+public:
+	struct ENTRY
+	{
+		int		col;	//!< column index
+		double	val;	//!< weight value
+	};
+
+public:
+	FEMortarWeights() : m_cols(0) {}
+
+	//! allocate storage (this also clears all weights)
+	void resize(int rows, int cols) { m_row.assign(rows, vector<ENTRY>()); m_cols = cols; }
+
+	//! clear all weights
+	void zero() { for (size_t i=0; i<m_row.size(); ++i) m_row[i].clear(); }
+
+	int rows() const { return (int) m_row.size(); }
+	int columns() const { return m_cols; }
+
+	//! the nonzero weights of row i
+	const vector<ENTRY>& row(int i) const { return m_row[i]; }
+
+	//! add a value to weight (i,j)
+	void add(int i, int j, double v);
+
+	//! return weight (i,j)
+	double operator () (int i, int j) const;
+
+private:
+	vector< vector<ENTRY> >	m_row;
+	int		m_cols;
+};
+
 //-----------------------------------------------------------------------------
 // Base class for mortar-type contact formulations
 class FEMortarInterface : public FEContactInterface
@@ -45,8 +83,8 @@ public:
 	void UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarContactSurface& ms);
 
 protected:
-	matrix	m_n1;	//!< integration weights n1_AB
-	matrix	m_n2;	//!< integration weights n2_AB
+	FEMortarWeights	m_n1;	//!< integration weights n1_AB
+	FEMortarWeights	m_n2;	//!< integration weights n2_AB
 
 private:
 	// integration rule
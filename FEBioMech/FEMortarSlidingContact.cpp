@@ -192,11 +192,13 @@ void FEMortarSlidingContact::BuildMatrixProfile(FEGlobalMatrix& K)
 void FEMortarSlidingContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 {
 	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
 
 	// loop over all primary nodes
 	for (int A=0; A<NS; ++A)
 	{
+		const vector<FEMortarWeights::ENTRY>& n1A = m_n1.row(A);
+		const vector<FEMortarWeights::ENTRY>& n2A = m_n2.row(A);
+
 		vec3d nuA = m_ss.m_nu[A];
 		vec3d gA = m_ss.m_gap[A];
 		double eps = m_eps*m_ss.m_A[A];
@@ -210,15 +212,16 @@ void FEMortarSlidingContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> en(1);
 		vector<int> lm(3);
 		vector<double> fe(3);
-		for (int B=0; B<NS; ++B)
+		for (size_t b=0; b<n1A.size(); ++b)
 		{
+			int B = n1A[b].col;
 			FENode& nodeB = m_ss.Node(B);
 			en[0] = m_ss.NodeIndex(B);
 			lm[0] = nodeB.m_ID[m_dofX];
 			lm[1] = nodeB.m_ID[m_dofY];
 			lm[2] = nodeB.m_ID[m_dofZ];
 
-			double nAB = -m_n1[A][B];
+			double nAB = -n1A[b].val;
 			if (nAB != 0.0)
 			{
 				fe[0] = tA.x*nAB;
@@ -230,15 +233,16 @@ void FEMortarSlidingContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		}
 
 		// loop over secondary side
-		for (int C=0; C<NM; ++C)
+		for (size_t c=0; c<n2A.size(); ++c)
 		{
+			int C = n2A[c].col;
 			FENode& nodeC = m_ms.Node(C);
 			en[0] = m_ms.NodeIndex(C);
 			lm[0] = nodeC.m_ID[m_dofX];
 			lm[1] = nodeC.m_ID[m_dofY];
 			lm[2] = nodeC.m_ID[m_dofZ];
 
-			double nAC = m_n2[A][C];
+			double nAC = n2A[c].val;
 			if (nAC != 0.0)
 			{
 				fe[0] = tA.x*nAC;
@@ -264,7 +268,6 @@ void FEMortarSlidingContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
 void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 {
 	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
 
 	// A. Linearization of the gap function
 	vector<int> lmi(3), lmj(3);
@@ -273,18 +276,22 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 	ke.resize(3, 3);
 	for (int A=0; A<NS; ++A)
 	{
+		const vector<FEMortarWeights::ENTRY>& n1A = m_n1.row(A);
+		const vector<FEMortarWeights::ENTRY>& n2A = m_n2.row(A);
+
 		vec3d nuA = m_ss.m_nu[A];
 		double eps = m_eps*m_ss.m_A[A];
 
 		// loop over all primary nodes
-		for (int B=0; B<NS; ++B)
+		for (size_t b=0; b<n1A.size(); ++b)
 		{
+			int B = n1A[b].col;
 			FENode& nodeB = m_ss.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = m_n1[A][B];
+			double nAB = n1A[b].val;
 			if (nAB != 0.0)
 			{
 				kA[0][0] = eps*nAB*(nuA.x*nuA.x); kA[0][1] = eps*nAB*(nuA.x*nuA.y); kA[0][2] = eps*nAB*(nuA.x*nuA.z);
@@ -292,14 +299,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (size_t c=0; c<n1A.size(); ++c)
 				{
+					int C = n1A[c].col;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C];
+					double nAC = n1A[c].val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -314,14 +322,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (size_t c=0; c<n2A.size(); ++c)
 				{
+					int C = n2A[c].col;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C];
+					double nAC = -n2A[c].val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -338,14 +347,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 		}
 
 		// loop over all secondary nodes
-		for (int B=0; B<NM; ++B)
+		for (size_t b=0; b<n2A.size(); ++b)
 		{
+			int B = n2A[b].col;
 			FENode& nodeB = m_ms.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = -m_n2[A][B];
+			double nAB = -n2A[b].val;
 			if (nAB != 0.0)
 			{
 				kA[0][0] = eps*nAB*(nuA.x*nuA.x); kA[0][1] = eps*nAB*(nuA.x*nuA.y); kA[0][2] = eps*nAB*(nuA.x*nuA.z);
@@ -353,14 +363,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (size_t c=0; c<n1A.size(); ++c)
 				{
+					int C = n1A[c].col;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C];
+					double nAC = n1A[c].val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -375,14 +386,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (size_t c=0; c<n2A.size(); ++c)
 				{
+					int C = n2A[c].col;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C];
+					double nAC = -n2A[c].val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -405,7 +417,6 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 {
 	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
 
 	vector<int> lm1(3);
 	vector<int> lm2(3);
@@ -421,6 +432,8 @@ void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 			int jp1 = (j+1)%nn;
 			int jm1 = (j+nn-1)%nn;
 			int A = f.m_lnode[j];
+			const vector<FEMortarWeights::ENTRY>& n1A = m_n1.row(A);
+			const vector<FEMortarWeights::ENTRY>& n2A = m_n2.row(A);
 
 			vec3d vA = m_ss.m_nu[A];
 			vec3d gA = m_ss.m_gap[A];
@@ -445,11 +458,12 @@ void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 			lm2[2] = nodej2.m_ID[2];
 
 			// loop over primary nodes
-			for (int B=0; B<NS; ++B)
+			for (size_t b=0; b<n1A.size(); ++b)
 			{
+				int B = n1A[b].col;
 				FENode& nodeB = m_ss.Node(B);
 				
-				double nAB = m_n1[A][B];
+				double nAB = n1A[b].val;
 				if (nAB != 0.0)
 				{
 					vector<int> lmi(3);
@@ -476,11 +490,12 @@ void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 			}
 
 			// loop over secondary nodes
-			for (int B=0; B<NM; ++B)
+			for (size_t b=0; b<n2A.size(); ++b)
 			{
+				int B = n2A[b].col;
 				FENode& nodeB = m_ms.Node(B);
 				
-				double nAB = m_n2[A][B];
+				double nAB = n2A[b].val;
 				if (nAB != 0.0)
 				{
 					vector<int> lmi(3);
@@ -135,11 +135,13 @@ void FEMortarTiedContact::BuildMatrixProfile(FEGlobalMatrix& K)
 void FEMortarTiedContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 {
 	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
 
 	// loop over all primary nodes
 	for (int A=0; A<NS; ++A)
 	{
+		const vector<FEMortarWeights::ENTRY>& n1A = m_n1.row(A);
+		const vector<FEMortarWeights::ENTRY>& n2A = m_n2.row(A);
+
 		double eps = m_eps*m_ss.m_A[A];
 		vec3d gA = m_ss.m_gap[A];
 		vec3d tA = m_ss.m_L[A] + gA*eps;
@@ -148,15 +150,16 @@ void FEMortarTiedContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> en(1);
 		vector<int> lm(3);
 		vector<double> fe(3);
-		for (int B=0; B<NS; ++B)
+		for (size_t b=0; b<n1A.size(); ++b)
 		{
+			int B = n1A[b].col;
 			FENode& nodeB = m_ss.Node(B);
 			en[0] = m_ss.NodeIndex(B);
 			lm[0] = nodeB.m_ID[m_dofX];
 			lm[1] = nodeB.m_ID[m_dofY];
 			lm[2] = nodeB.m_ID[m_dofZ];
 
-			double nAB = -m_n1[A][B];
+			double nAB = -n1A[b].val;
 			if (nAB != 0.0)
 			{
 				fe[0] = tA.x*nAB;
@@ -168,15 +171,16 @@ void FEMortarTiedContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		}
 
 		// loop over secondary side
-		for (int C=0; C<NM; ++C)
+		for (size_t c=0; c<n2A.size(); ++c)
 		{
+			int C = n2A[c].col;
 			FENode& nodeC = m_ms.Node(C);
 			en[0] = m_ms.NodeIndex(C);
 			lm[0] = nodeC.m_ID[m_dofX];
 			lm[1] = nodeC.m_ID[m_dofY];
 			lm[2] = nodeC.m_ID[m_dofZ];
 
-			double nAC = m_n2[A][C];
+			double nAC = n2A[c].val;
 			if (nAC != 0.0)
 			{
 				fe[0] = tA.x*nAC;
@@ -194,7 +198,6 @@ void FEMortarTiedContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 void FEMortarTiedContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp)
 {
 	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
 
 	// A. Linearization of the gap function
 	vector<int> lmi(3), lmj(3);
@@ -202,28 +205,33 @@ void FEMortarTiedContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 	ke.resize(3, 3);
 	for (int A=0; A<NS; ++A)
 	{
+		const vector<FEMortarWeights::ENTRY>& n1A = m_n1.row(A);
+		const vector<FEMortarWeights::ENTRY>& n2A = m_n2.row(A);
+
 		double eps = m_eps*m_ss.m_A[A];
 
 		// loop over all primary nodes
-		for (int B=0; B<NS; ++B)
+		for (size_t b=0; b<n1A.size(); ++b)
 		{
+			int B = n1A[b].col;
 			FENode& nodeB = m_ss.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = m_n1[A][B]*eps;
+			double nAB = n1A[b].val*eps;
 			if (nAB != 0.0)
 			{
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (size_t c=0; c<n1A.size(); ++c)
 				{
+					int C = n1A[c].col;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C]*nAB;
+					double nAC = n1A[c].val*nAB;
 					if (nAC != 0.0)
 					{
 						ke[0][0] = nAC; ke[0][1] = 0.0; ke[0][2] = 0.0;
@@ -236,14 +244,15 @@ void FEMortarTiedContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (size_t c=0; c<n2A.size(); ++c)
 				{
+					int C = n2A[c].col;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C]*nAB;
+					double nAC = -n2A[c].val*nAB;
 					if (nAC != 0.0)
 					{
 						ke[0][0] = nAC; ke[0][1] = 0.0; ke[0][2] = 0.0;
@@ -258,25 +267,27 @@ void FEMortarTiedContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		}
 
 		// loop over all secondary nodes
-		for (int B=0; B<NM; ++B)
+		for (size_t b=0; b<n2A.size(); ++b)
 		{
+			int B = n2A[b].col;
 			FENode& nodeB = m_ms.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = -m_n2[A][B]*eps;
+			double nAB = -n2A[b].val*eps;
 			if (nAB != 0.0)
 			{
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (size_t c=0; c<n1A.size(); ++c)
 				{
+					int C = n1A[c].col;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C]*nAB;
+					double nAC = n1A[c].val*nAB;
 					if (nAC != 0.0)
 					{
 						ke[0][0] = nAC; ke[0][1] = 0.0; ke[0][2] = 0.0;
@@ -289,14 +300,15 @@ void FEMortarTiedContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (size_t c=0; c<n2A.size(); ++c)
 				{
+					int C = n2A[c].col;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C]*nAB;
+					double nAC = -n2A[c].val*nAB;
 					if (nAC != 0.0)
 					{
 						ke[0][0] = nAC; ke[0][1] = 0.0; ke[0][2] = 0.0;
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FENeoHookean.h"
+#include "FEElasticBatch.h"
 
 //-----------------------------------------------------------------------------
 // define the material parameters
@@ -95,6 +96,75 @@ tens4ds FENeoHookean::Tangent(FEMaterialPoint& mp)
 	return tens4ds(D);
 }
 
+//-----------------------------------------------------------------------------
+void FENeoHookean::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	FEElasticBatch B;
+	double E[NMAX], v[NMAX], S[6][NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		B.Gather(mp + k, m);
+		FEElasticBatch::Evaluate(m_E, mp + k, m, E);
+		FEElasticBatch::Evaluate(m_v, mp + k, m, v);
+
+		for (int i = 0; i < m; ++i)
+		{
+			double detFi = 1.0 / B.m_J[i];
+			double lam = v[i]*E[i]/((1+v[i])*(1-2*v[i]));
+			double mu  = 0.5*E[i]/(1+v[i]);
+			double a = mu*detFi;
+			double d = (lam*log(B.m_J[i]) - mu)*detFi;
+
+			// s = (b - I)*(mu/J) + I*(lam*lnJ/J)
+			S[0][i] = B.m_b[0][i]*a + d;
+			S[1][i] = B.m_b[1][i]*a + d;
+			S[2][i] = B.m_b[2][i]*a + d;
+			S[3][i] = B.m_b[3][i]*a;
+			S[4][i] = B.m_b[4][i]*a;
+			S[5][i] = B.m_b[5][i]*a;
+		}
+
+		FEElasticBatch::Store(S, m, s + k);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C)
+{
+	const int NMAX = FEElasticBatch::MAX_POINTS;
+	double E[NMAX], v[NMAX], lam1[NMAX], mu1[NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		double J[NMAX];
+		for (int i = 0; i < m; ++i) J[i] = mp[k + i]->ExtractData<FEElasticMaterialPoint>()->m_J;
+		FEElasticBatch::Evaluate(m_E, mp + k, m, E);
+		FEElasticBatch::Evaluate(m_v, mp + k, m, v);
+
+		for (int i = 0; i < m; ++i)
+		{
+			double lam = v[i]*E[i]/((1+v[i])*(1-2*v[i]));
+			double mu  = 0.5*E[i]/(1+v[i]);
+			lam1[i] = lam / J[i];
+			mu1[i]  = (mu - lam*log(J[i])) / J[i];
+		}
+
+		for (int i = 0; i < m; ++i)
+		{
+			double D[6][6] = {0};
+			D[0][0] = lam1[i]+2.*mu1[i]; D[0][1] = lam1[i]          ; D[0][2] = lam1[i]          ;
+			D[1][0] = lam1[i]          ; D[1][1] = lam1[i]+2.*mu1[i]; D[1][2] = lam1[i]          ;
+			D[2][0] = lam1[i]          ; D[2][1] = lam1[i]          ; D[2][2] = lam1[i]+2.*mu1[i];
+			D[3][3] = mu1[i];
+			D[4][4] = mu1[i];
+			D[5][5] = mu1[i];
+			C[k + i] = tens4ds(D);
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FENeoHookean::StrainEnergyDensity(FEMaterialPoint& mp)
 {
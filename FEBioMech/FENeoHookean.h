@@ -50,6 +50,12 @@ public:
 	//! calculate tangent stiffness at material point
 	virtual tens4ds Tangent(FEMaterialPoint& pt) override;
 
+	//! calculate stress at n material points
+	void StressBatch(FEMaterialPoint** mp, int n, mat3ds* s) override;
+
+	//! calculate tangent stiffness at n material points
+	void TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C) override;
+
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
     
@@ -953,9 +953,16 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingElasticSurface& ss = (np == 0? m_ss : m_ms);
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
+        // contact forces on the primary and secondary surface
+        double fsx = 0, fsy = 0, fsz = 0;
+        double fmx = 0, fmy = 0, fmz = 0;
+        
         // loop over all primary elements
-        //#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N)
-        for (int i=0; i<ss.Elements(); ++i)
+        // (ContactTraction only modifies the integration point data of the
+        // primary element, so the elements can be processed concurrently)
+        int NE = ss.Elements();
+        #pragma omp parallel for schedule(dynamic) private(sLM, mLM, LM, en, fe, detJ, w, Hm, N) reduction(+:fsx,fsy,fsz,fmx,fmy,fmz)
+        for (int i=0; i<NE; ++i)
         {
             // get the surface element
             FESurfaceElement& se = ss.Element(i);
@@ -1064,12 +1071,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
                         {
-                            ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                            fsx += fe[k*3]; fsy += fe[k*3+1]; fsz += fe[k*3+2];
                         }
                         
                         for (int k = 0; k<nmeln; ++k)
                         {
-                            ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                            fmx += fe[(k + nseln) * 3]; fmy += fe[(k + nseln) * 3 + 1]; fmz += fe[(k + nseln) * 3 + 2];
                         }
                         
                         // assemble the global residual
@@ -1078,6 +1085,9 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+        
+        ss.m_Ft += vec3d(fsx, fsy, fsz);
+        ms.m_Ft += vec3d(fmx, fmy, fmz);
     }
 }
 
@@ -1105,8 +1115,9 @@ void FESlidingElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETime
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
         // loop over all primary elements
-        //#pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
-        for (int i=0; i<ss.Elements(); ++i)
+        int NE = ss.Elements();
+        #pragma omp parallel for schedule(dynamic) private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
+        for (int i=0; i<NE; ++i)
         {
             // get ths primary element
             FESurfaceElement& se = ss.Element(i);
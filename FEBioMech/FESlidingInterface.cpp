@@ -407,11 +407,20 @@ FESlidingInterface::FESlidingInterface(FEModel* pfem) : FEContactInterface(pfem)
 	m_btwo_pass = false; // don't use two-pass
 	m_sradius = 0;				// no search radius limitation
 
+	m_cpp[0] = m_cpp[1] = nullptr;
+
 	// set the siblings
 	m_ms.SetSibling(&m_ss);
 	m_ss.SetSibling(&m_ms);
 };
 
+//-----------------------------------------------------------------------------
+FESlidingInterface::~FESlidingInterface()
+{
+	delete m_cpp[0];
+	delete m_cpp[1];
+}
+
 //-----------------------------------------------------------------------------
 //! Calculates the auto penalty factor
 
@@ -501,14 +510,25 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 	double r, s;
 	vec3d q;
 
-	FEClosestPointProjection cpp(ms);
-	cpp.SetTolerance(m_stol);
-	cpp.SetSearchRadius(m_sradius);
-	cpp.HandleSpecialCases(true);
-	cpp.Init();
+	// The projection data is created the first time and after that we only
+	// need to update the search structure to the current configuration.
+	int np = (&ms == &m_ms ? 0 : 1);
+	if (m_cpp[np] == nullptr)
+	{
+		m_cpp[np] = new FEClosestPointProjection(ms);
+		m_cpp[np]->SetTolerance(m_stol);
+		m_cpp[np]->SetSearchRadius(m_sradius);
+		m_cpp[np]->HandleSpecialCases(true);
+		m_cpp[np]->Init();
+	}
+	else m_cpp[np]->Update();
+	FEClosestPointProjection& cpp = *m_cpp[np];
 
 	// loop over all primary surface nodes
-	for (int i=0; i<ss.Nodes(); ++i)
+	// (nodes are relocated when bmove is set, so in that case we stay serial)
+	int NN = ss.Nodes();
+#pragma omp parallel for schedule(dynamic) private(r, s, q) if(bmove == false)
+	for (int i=0; i<NN; ++i)
 	{
 		// get the node
 		FENode& node = ss.Node(i);
@@ -699,6 +719,7 @@ void FESlidingInterface::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 
 		// loop over all primary surface facets
 		int ne = ss.Elements();
+		#pragma omp parallel for schedule(dynamic) private(fe, lm, en, sLM, mLM, r0, w, Gr, Gs, detJ, dxr, dxs)
 		for (int j=0; j<ne; ++j)
 		{
 			// get the next element
@@ -1037,6 +1058,7 @@ void FESlidingInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& t
 
 		// loop over all primary surface elements
 		int ne = ss.Elements();
+		#pragma omp parallel for schedule(dynamic) private(ke, Gr, Gs, w, r0, detJ, dxr, dxs, sLM, mLM) firstprivate(lm, en)
 		for (int j=0; j<ne; ++j)
 		{
 			// unpack the next element
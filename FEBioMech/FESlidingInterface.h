@@ -93,7 +93,7 @@ public:
 	FESlidingInterface(FEModel* pfem);
 
 	//! destructor
-	virtual ~FESlidingInterface(){}
+	virtual ~FESlidingInterface();
 
 	//! Initializes sliding interface
 	bool Init() override;
@@ -184,6 +184,8 @@ private:
 	bool	m_bfirst;	//!< flag to indicate the first time we enter Update
 	double	m_normg0;	//!< initial gap norm
 
+	FEClosestPointProjection*	m_cpp[2];	//!< closest point projection onto secondary (0) and primary (1) surface
+
 public:
 	DECLARE_FECORE_CLASS();
 };
@@ -109,8 +109,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						if (I >= 0)
 						{
 							// dof i is not a prescribed degree of freedom
-							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							if (K.AtomicAssembly())
+							{
+								#pragma omp atomic
+								m_F[I] -= ke[i][j] * ui[J];
+							}
+							else m_F[I] -= ke[i][j] * ui[J];
 						}
 					}
 
@@ -121,7 +125,19 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 
 		// see if there are any rigid body dofs here
-		#pragma omp critical 
-		m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		// (only enter the critical section if the element has rigid nodes)
+		FEMesh& mesh = fem->GetMesh();
+		const vector<int>& en = ke.Nodes();
+		bool brigid = false;
+		for (int i = 0; i < (int)en.size(); ++i)
+		{
+			if ((en[i] >= 0) && (mesh.Node(en[i]).m_rid >= 0)) { brigid = true; break; }
+		}
+
+		if (brigid)
+		{
+			#pragma omp critical 
+			m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		}
 	}
 }
@@ -63,6 +63,44 @@ tens4dmm FESolidMaterial::SolidTangent(FEMaterialPoint& mp)
 	return m_secant_tangent ? SecantTangent(mp) : Tangent(mp);
 }
 
+//-----------------------------------------------------------------------------
+void FESolidMaterial::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	for (int i = 0; i < n; ++i) s[i] = Stress(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FESolidMaterial::TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C)
+{
+	for (int i = 0; i < n; ++i) C[i] = Tangent(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FESolidMaterial::SolidStressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	for (int i = 0; i < n; ++i) s[i] = SolidStress(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FESolidMaterial::SolidTangentBatch(FEMaterialPoint** mp, int n, tens4dmm* C)
+{
+	if (m_secant_tangent)
+	{
+		for (int i = 0; i < n; ++i) C[i] = SecantTangent(*mp[i]);
+		return;
+	}
+
+	// evaluate the tangents in chunks and convert to tens4dmm
+	const int NMAX = 16;
+	tens4ds D[NMAX];
+	for (int k = 0; k < n; k += NMAX)
+	{
+		int m = (n - k < NMAX ? n - k : NMAX);
+		TangentBatch(mp + k, m, D);
+		for (int i = 0; i < m; ++i) C[k + i] = tens4dmm(D[i]);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! calculate the 2nd Piola-Kirchhoff stress at material point, using prescribed Lagrange strain
 //! needed for EAS analyses where the compatible strain (calculated from displacements) is enhanced
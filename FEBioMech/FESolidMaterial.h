@@ -69,6 +69,24 @@ public:
 
 	tens4dmm SolidTangent(FEMaterialPoint& pt);
 
+public:
+	// Batched versions of the functions above. These evaluate the constitutive
+	// relations for an array of n material points at once. The default 
+	// implementations simply loop over the points, but materials can override 
+	// these to vectorize the evaluation (see FEElasticBatch).
+
+	//! calculate stress at n material points
+	virtual void StressBatch(FEMaterialPoint** mp, int n, mat3ds* s);
+
+	//! calculate tangent stiffness at n material points
+	virtual void TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C);
+
+	//! calculate the solid stress at n material points
+	virtual void SolidStressBatch(FEMaterialPoint** mp, int n, mat3ds* s);
+
+	//! calculate the solid tangent at n material points
+	void SolidTangentBatch(FEMaterialPoint** mp, int n, tens4dmm* C);
+
 protected:
 	FEParamDouble	m_density;	//!< material density
     
@@ -48,6 +48,7 @@ SOFTWARE.*/
 #include <FECore/FEModelLoad.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/vector.h>
+#include <FECore/FEProfiler.h>
 #include "FESolidLinearSystem.h"
 #include "FEBioMech.h"
 
@@ -62,6 +63,7 @@ BEGIN_FECORE_CLASS(FESolidSolver2, FENewtonSolver)
 	ADD_PARAMETER(m_logSolve     , "logSolve"    );
 	ADD_PARAMETER(m_arcLength    , "arc_length"  );
 	ADD_PARAMETER(m_al_scale     , "arc_length_scale");
+	ADD_PARAMETER(m_bcacheGradients, "cache_gradients");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -81,6 +83,7 @@ m_dofU(pfem), m_dofV(pfem), m_dofSQ(pfem), m_dofRQ(pfem), m_dofSU(pfem), m_dofSV
 	m_nreq = 0;
 
 	m_logSolve = false;
+	m_bcacheGradients = false;
 
 	// default Newmark parameters (trapezoidal rule)
     m_rhoi = -2;
@@ -248,6 +251,9 @@ bool FESolidSolver2::Init()
         FEElasticShellDomain* s = dynamic_cast<FEElasticShellDomain*>(&mesh.Domain(i));
 		if (d) d->SetDynamicUpdateFlag(b);
         if (s) s->SetDynamicUpdateFlag(b);
+
+		FESolidDomain* sd = dynamic_cast<FESolidDomain*>(&mesh.Domain(i));
+		if (sd) sd->EnableGradientCache(m_bcacheGradients);
 	}
 
 	return true;
@@ -374,6 +380,10 @@ void FESolidSolver2::UpdateKinematics(vector<double>& ui)
 	// get the mesh
 	FEMesh& mesh = fem.GetMesh();
 
+	// The nodal positions are about to change, which invalidates data that was 
+	// evaluated for the current configuration (e.g. the solid domain gradient cache).
+	fem.IncrementUpdateCounter();
+
 	// update rigid bodies
 	m_rigidSolver.UpdateRigidBodies(m_Ui, ui);
 
@@ -1082,6 +1092,8 @@ bool FESolidSolver2::StiffnessMatrix()
 		if (mesh.Domain(i).IsActive()) 
 		{
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
+			FEMaterial* mat = mesh.Domain(i).GetMaterial();
+			FEProfileScope prof("domain", (mat ? mat->GetTypeStr() : nullptr));
 			dom.StiffnessMatrix(LS);
 		}
 	}
@@ -1119,7 +1131,10 @@ bool FESolidSolver2::StiffnessMatrix()
 	}
 
 	// calculate contact stiffness
-	ContactStiffness(LS);
+	{
+		FE_PROFILE("contact");
+		ContactStiffness(LS);
+	}
 
 	// calculate stiffness matrices for surface loads
 	// for arclength method we need to apply the scale factor to all the 
@@ -1173,7 +1188,11 @@ void FESolidSolver2::ContactStiffness(FELinearSystem& LS)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+		if (pci->IsActive())
+		{
+			FEProfileScope prof("interface", pci->GetTypeStr());
+			pci->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1186,7 +1205,11 @@ void FESolidSolver2::ContactForces(FEGlobalVector& R)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->LoadVector(R, tp);
+		if (pci->IsActive())
+		{
+			FEProfileScope prof("interface", pci->GetTypeStr());
+			pci->LoadVector(R, tp);
+		}
 	}
 }
 
@@ -1286,6 +1309,7 @@ void FESolidSolver2::InternalForces(FEGlobalVector& R)
 		if ((mat == nullptr) || (mat->IsRigid() == false))
 		{
 			FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
+			FEProfileScope prof("domain", (mat ? mat->GetTypeStr() : nullptr));
 			edom.InternalForces(R);
 		}
 	}
@@ -1348,7 +1372,10 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	}
 
 	// calculate contact forces
-	ContactForces(RHS);
+	{
+		FE_PROFILE("contact");
+		ContactForces(RHS);
+	}
 
 	// calculate nonlinear constraint forces
 	// note that these are the linear constraints
@@ -138,6 +138,7 @@ public:
 	double	m_Dtol;			//!< displacement tolerance
 
 	bool	m_logSolve;		//!< flag to use Aggarwal's log method
+	bool	m_bcacheGradients;	//!< cache the spatial shape function gradients of solid domains
 
 	// equation numbers
 	int		m_nreq;			//!< start of rigid body equations
@@ -220,7 +220,8 @@ void FEUDGHexDomain::StiffnessMatrix(FELinearSystem& LS)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 
 		// create the element's stiffness matrix
 		int ndof = 3*el.Nodes();
@@ -119,6 +119,48 @@ tens4ds FEUncoupledMaterial::Tangent(FEMaterialPoint &mp)
 	return DevTangent(mp) + (IxI - I4*2)*p + IxI*(UJJ(pt.m_J)*pt.m_J);
 }
 
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::DevStressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	for (int i = 0; i < n; ++i) s[i] = DevStress(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::DevTangentBatch(FEMaterialPoint** mp, int n, tens4ds* C)
+{
+	for (int i = 0; i < n; ++i) C[i] = DevTangent(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+//! Batched version of Stress.
+void FEUncoupledMaterial::StressBatch(FEMaterialPoint** mp, int n, mat3ds* s)
+{
+	DevStressBatch(mp, n, s);
+	for (int i = 0; i < n; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		s[i] += mat3dd(UJ(pt.m_J));
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Batched version of Tangent.
+void FEUncoupledMaterial::TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C)
+{
+	DevTangentBatch(mp, n, C);
+
+	mat3dd I(1);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+	for (int i = 0; i < n; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		double J = pt.m_J;
+		double p = UJ(J);
+		C[i] += (IxI - I4*2)*p + IxI*(UJJ(J)*J);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! The strain energy density function calculates the total sed as a sum of
 //! two terms, namely the deviatoric sed and U(J).
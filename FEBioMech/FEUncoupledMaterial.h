@@ -69,6 +69,12 @@ public:
 	//! Deviatoric spatial Tangent
 	virtual tens4ds DevTangent(FEMaterialPoint& mp) = 0;
 
+	//! Deviatoric Cauchy stress at n material points
+	virtual void DevStressBatch(FEMaterialPoint** mp, int n, mat3ds* s);
+
+	//! Deviatoric spatial tangent at n material points
+	virtual void DevTangentBatch(FEMaterialPoint** mp, int n, tens4ds* C);
+
 	//! Deviatoric strain energy density
 	virtual double DevStrainEnergyDensity(FEMaterialPoint& mp) { return 0; }
     
@@ -118,6 +124,12 @@ public:
 	//! total spatial tangent (do not overload!)
 	tens4ds Tangent(FEMaterialPoint& mp) final;
 
+	//! total Cauchy stress at n material points (do not overload!)
+	void StressBatch(FEMaterialPoint** mp, int n, mat3ds* s) final;
+
+	//! total spatial tangent at n material points (do not overload!)
+	void TangentBatch(FEMaterialPoint** mp, int n, tens4ds* C) final;
+
 	//! calculate strain energy (do not overload!)
 	double StrainEnergyDensity(FEMaterialPoint& pt) final;
 
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBiphasic.h"
+#include <typeinfo>
 #include "FECore/FECoreKernel.h"
 
 //-----------------------------------------------------------------------------
@@ -67,6 +68,29 @@ void FEBiphasicMaterialPoint::Serialize(DumpStream& ar)
     ar & m_ss;
 }
 
+//-----------------------------------------------------------------------------
+int FEBiphasicMaterialPoint::StateSize() const
+{
+	// derived classes may have more data, so they need to be serialized
+	if (typeid(*this) != typeid(FEBiphasicMaterialPoint)) return -1;
+	return (int)((6*sizeof(double) + 3*sizeof(vec3d) + sizeof(mat3ds)) / sizeof(double));
+}
+
+//-----------------------------------------------------------------------------
+void FEBiphasicMaterialPoint::CopyState(double*& pd, bool bsave)
+{
+	CopyValue(m_p, pd, bsave);
+	CopyValue(m_gradp, pd, bsave);
+	CopyValue(m_gradpp, pd, bsave);
+	CopyValue(m_w, pd, bsave);
+	CopyValue(m_pa, pd, bsave);
+	CopyValue(m_phi0, pd, bsave);
+	CopyValue(m_phi0p, pd, bsave);
+	CopyValue(m_phi0hat, pd, bsave);
+	CopyValue(m_Jp, pd, bsave);
+	CopyValue(m_ss, pd, bsave);
+}
+
 //-----------------------------------------------------------------------------
 void FEBiphasicMaterialPoint::Init()
 {
@@ -49,6 +49,9 @@ public:
 	//! data serialization
 	void Serialize(DumpStream& ar) override;
 
+	int StateSize() const override;
+	void CopyState(double*& pd, bool bsave) override;
+
 	//! Data initialization
 	void Init() override;
 
@@ -438,7 +438,8 @@ void FEBiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         int neln = el.Nodes();
         int ndof = neln*8;
         ke.resize(ndof, ndof);
@@ -446,7 +447,7 @@ void FEBiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
         // calculate the element stiffness matrix
         ElementBiphasicStiffness(el, ke, bsymm);
         
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -467,7 +468,8 @@ void FEBiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         int neln = el.Nodes();
         int ndof = neln*8;
         ke.resize(ndof, ndof);
@@ -475,7 +477,7 @@ void FEBiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
         // calculate the element stiffness matrix
         ElementBiphasicStiffnessSS(el, ke, bsymm);
         
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
@@ -1061,7 +1063,8 @@ void FEBiphasicShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FEShellElement& el = m_Elem[iel];
         
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int neln = el.Nodes();
         int ndof = 8*neln;
         ke.resize(ndof, ndof);
@@ -498,7 +498,8 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = el.Nodes()*4;
 		ke.resize(ndof, ndof);
 		
@@ -510,7 +511,7 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		// have to create a new lm array and place the equation numbers in the right order.
 		// What we really ought to do is fix the UnpackLM function so that it returns
 		// the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -531,7 +532,8 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int ndof = el.Nodes()*4;
 		ke.resize(ndof, ndof);
 		
@@ -543,7 +545,7 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		// have to create a new lm array and place the equation numbers in the right order.
 		// What we really ought to do is fix the UnpackLM function so that it returns
 		// the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -1026,7 +1028,8 @@ void FEBiphasicSolidDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
         int neln = el.Nodes();
         int ndof = 4*neln;
         ke.resize(ndof, ndof);
@@ -1040,7 +1043,7 @@ void FEBiphasicSolidDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         // have to create a new lm array and place the equation numbers in the right order.
         // What we really ought to do is fix the UnpackLM function so that it returns
         // the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
         
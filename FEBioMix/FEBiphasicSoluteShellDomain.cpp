@@ -563,7 +563,8 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         
         // allocate stiffness matrix
         int neln = el.Nodes();
@@ -574,7 +575,7 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm
         ElementBiphasicSoluteStiffness(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -597,7 +598,8 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsy
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
         int neln = el.Nodes();
         int ndof = neln*10;
         ke.resize(ndof, ndof);
@@ -606,7 +608,7 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsy
         ElementBiphasicSoluteStiffnessSS(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -468,10 +468,16 @@ double FEMultiphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 		else return 0.0;
 	}
 	
+	// use the stored solution if it is up to date
+	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
+	if (set.m_bzeta) {
+		if (eform) return set.m_zeta;
+		else return -m_Rgas*m_Tabs/m_Fc*log(set.m_zeta);
+	}
+
 	int i, j;
 	
 	// if not neutral, solve electroneutrality polynomial for zeta
-	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
 	const int nsol = (int)m_pSolute.size();
 	double cF = FixedChargeDensity(pt);
 
@@ -517,6 +523,17 @@ double FEMultiphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 	return psi;
 }
 
+//-----------------------------------------------------------------------------
+//! Solve the electroneutrality condition once for the current state. The solution
+//! is reused by the partition coefficients, fluxes, stress and tangent.
+void FEMultiphasic::UpdateElectricPotential(FEMaterialPoint& pt)
+{
+	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
+	set.m_bzeta = false;
+	set.m_zeta = ElectricPotential(pt, true);
+	set.m_bzeta = true;
+}
+
 //-----------------------------------------------------------------------------
 //! partition coefficient
 double FEMultiphasic::PartitionCoefficient(FEMaterialPoint& pt, const int sol)
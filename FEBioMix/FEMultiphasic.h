@@ -105,6 +105,11 @@ public:
 	
 	//! electric potential
 	double ElectricPotential(FEMaterialPoint& pt, const bool eform=false);
+
+	//! Solve for the electric potential of the current state and store it in the material point.
+	//! Subsequent calls to ElectricPotential (and the functions that depend on it) use the stored
+	//! value until this function is called again. Must be called whenever the state changes.
+	void UpdateElectricPotential(FEMaterialPoint& pt);
 	
 	//! current density
 	vec3d CurrentDensity(FEMaterialPoint& pt);
@@ -352,6 +352,9 @@ void FEMultiphasicShellDomain::InitMaterialPoints()
             FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
             FESolutesMaterialPoint& ps = *(mp.ExtractData<FESolutesMaterialPoint>());
             
+            // the electric potential is recomputed for the initial state
+            ps.m_bzeta = false;
+            
             // initialize effective fluid pressure, its gradient, and fluid flux
             pt.m_p = evaluate(el, p0, q0, n);
             pt.m_gradp = gradient(el, p0, q0, n);
@@ -884,7 +887,8 @@ void FEMultiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 		int neln = el.Nodes();
         int ndof = neln*ndpn;
         ke.resize(ndof, ndof);
@@ -893,7 +897,7 @@ void FEMultiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
         ElementMultiphasicStiffness(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -919,7 +923,8 @@ void FEMultiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
         int neln = el.Nodes();
         int ndof = neln*ndpn;
         ke.resize(ndof, ndof);
@@ -927,7 +932,7 @@ void FEMultiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
         // calculate the element stiffness matrix
         ElementMultiphasicStiffnessSS(el, ke, bsymm);
 
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -2056,7 +2061,8 @@ void FEMultiphasicShellDomain::MembraneReactionStiffnessMatrix(FELinearSystem& L
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
 
 		vector<int> lm;
         UnpackMembraneLM(el, lm);
@@ -2385,6 +2391,9 @@ void FEMultiphasicShellDomain::UpdateElementStress(int iel, const FETimeInfo& tp
         // calculate the gradient of p at gauss-point
         ppt.m_gradp = gradient(el, pn, qn, n);
         
+        // solve for the electric potential of the updated state
+        pmb->UpdateElectricPotential(mp);
+        
         // update the fluid and solute fluxes
         // and evaluate the actual fluid pressure and solute concentration
         ppt.m_w = pmb->FluidFlux(mp);
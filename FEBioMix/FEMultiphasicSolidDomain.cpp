@@ -323,6 +323,9 @@ void FEMultiphasicSolidDomain::InitMaterialPoints()
             FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
             FESolutesMaterialPoint& ps = *(mp.ExtractData<FESolutesMaterialPoint>());
             
+            // the electric potential is recomputed for the initial state
+            ps.m_bzeta = false;
+            
             // initialize effective fluid pressure, its gradient, and fluid flux
             pt.m_p = el.Evaluate(p0, n);
             pt.m_gradp = gradient(el, p0, n);
@@ -783,7 +786,8 @@ void FEMultiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
 
         // allocate stiffness matrix
         int neln = el.Nodes();
@@ -794,7 +798,7 @@ void FEMultiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
         ElementMultiphasicStiffness(el, ke, bsymm);
 
 		// get the lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -818,7 +822,8 @@ void FEMultiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        static thread_local FEElementMatrix ke;
+        ke.SetElement(el);
 
         // allocate stiffness matrix
         int neln = el.Nodes();
@@ -829,7 +834,7 @@ void FEMultiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
         ElementMultiphasicStiffnessSS(el, ke, bsymm);
 
 		// get the lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
@@ -1684,6 +1689,9 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
             spt.m_gradc[k] = gradient(el, &ct[k][0], n);
         }
         
+        // solve for the electric potential of the updated state
+        pmb->UpdateElectricPotential(mp);
+        
         // update the fluid and solute fluxes
         // and evaluate the actual fluid pressure and solute concentration
         ppt.m_w = pmb->FluidFlux(mp);
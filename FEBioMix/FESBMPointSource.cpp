@@ -98,6 +98,7 @@ void FESBMPointSource::Update()
 		FESolutesMaterialPoint& pd = *(mp->ExtractData<FESolutesMaterialPoint>());
 		pd.m_sbmr[sbmid] = val;
 		pd.m_sbmrp[sbmid] = val;
+		pd.m_bzeta = false;
 	}
 }
 
@@ -152,6 +153,7 @@ void FESBMPointSource::ResetSBM()
 						FESolutesMaterialPoint& pd = *(mp->ExtractData<FESolutesMaterialPoint>());
 						pd.m_sbmr[sbmid] = 0.0;
 						pd.m_sbmrp[sbmid] = 0.0;
+						pd.m_bzeta = false;
 					}
 				}
 			}
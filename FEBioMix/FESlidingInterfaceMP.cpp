@@ -1293,8 +1293,14 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurfaceMP& ms = (np == 0? m_ms : m_ss);
 		vector<int>& sl = (np == 0? m_ssl : m_msl);
 		
+		// contact forces on the primary and secondary surface
+		double fsx = 0, fsy = 0, fsz = 0;
+		double fmx = 0, fmy = 0, fmz = 0;
+		
 		// loop over all primary surface elements
-		for (int i=0; i<ss.Elements(); ++i)
+		int NE = ss.Elements();
+		#pragma omp parallel for schedule(dynamic) private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N, tn, wn) firstprivate(jn) reduction(+:fsx,fsy,fsz,fmx,fmy,fmz)
+		for (int i=0; i<NE; ++i)
 		{
 			// get the surface element
 			FESurfaceElement& se = ss.Element(i);
@@ -1420,12 +1426,12 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 					
                     for (int k=0; k<nseln; ++k)
                     {
-                        ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                        fsx += fe[k*3]; fsy += fe[k*3+1]; fsz += fe[k*3+2];
                     }
                     
                     for (int k = 0; k<nmeln; ++k)
                     {
-                        ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                        fmx += fe[(k + nseln) * 3]; fmy += fe[(k + nseln) * 3 + 1]; fmz += fe[(k + nseln) * 3 + 2];
                     }
                     
 					// assemble the global residual
@@ -1484,6 +1490,9 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 				}
 			}
 		}
+		
+		ss.m_Ft += vec3d(fsx, fsy, fsz);
+		ms.m_Ft += vec3d(fmx, fmy, fmz);
 	}
 }
 
@@ -1534,7 +1543,9 @@ void FESlidingInterfaceMP::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		vector<int>& sl = (np == 0? m_ssl : m_msl);
 		
 		// loop over all primary surface elements
-		for (i=0; i<ss.Elements(); ++i)
+		int NE = ss.Elements();
+		#pragma omp parallel for schedule(dynamic) private(j, k, l, sLM, mLM, LM, en, detJ, w, Hs, Hm, ke, tn, wn, pv) firstprivate(jn, qv)
+		for (i=0; i<NE; ++i)
 		{
 			// get the next element
 			FESurfaceElement& se = ss.Element(i);
@@ -50,6 +50,8 @@ void FESolutesMaterialPoint::Init()
 {
 	m_nsol = m_nsbm = 0;
 	m_psi = m_cF = 0;
+	m_zeta = 1;
+	m_bzeta = false;
 	m_Ie = vec3d(0,0,0);
 	m_rhor = 0;
     m_c.clear();
@@ -99,4 +101,7 @@ void FESolutesMaterialPoint::Serialize(DumpStream& ar)
 	ar & m_strain & m_pe & m_pi;
 	ar & m_ce & m_ide;
 	ar & m_ci & m_idi;
+
+	// the stored electric potential must be recomputed for the restored state
+	if (ar.IsLoading()) m_bzeta = false;
 }
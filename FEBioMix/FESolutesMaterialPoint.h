@@ -57,6 +57,8 @@ public:
 	vector<double>	m_ca;		//!< actual solute concentration
     vector<double>  m_crp;      //!< referential actual solute concentration at previous time step
 	double			m_psi;		//!< electric potential
+	double			m_zeta;		//!< exponential form of electric potential for the current state (valid if m_bzeta is set)
+	bool			m_bzeta;	//!< flag indicating that m_zeta is up to date
 	vec3d			m_Ie;		//!< current density
 	double			m_cF;		//!< fixed charge density in current configuration
 	int				m_nsbm;		//!< number of solid-bound molecules
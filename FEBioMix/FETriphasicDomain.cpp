@@ -530,10 +530,11 @@ void FETriphasicDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 
 		// get the lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 		
@@ -563,7 +564,8 @@ void FETriphasicDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		static thread_local FEElementMatrix ke;
+		ke.SetElement(el);
 
 		// allocate stiffness matrix
 		int neln = el.Nodes();
@@ -575,7 +577,7 @@ void FETriphasicDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		ElementTriphasicStiffnessSS(el, ke, bsymm);
 
 		//  get the lm vector
-		vector<int> lm;
+		static thread_local vector<int> lm;
 		UnpackLM(el, lm);
 		ke.SetIndices(lm);
 
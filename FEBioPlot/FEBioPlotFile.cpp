@@ -688,9 +688,19 @@ FEBioPlotFile::LineObject* FEBioPlotFile::AddLineObject(const std::string& name)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::SetCompression(int n)
 {
+#ifndef HAVE_ZLIB
+	// block compression requires zlib, so don't flag the file as block compressed
+	if (n == FileStream::COMPRESS_BLOCKS) n = FileStream::COMPRESS_NONE;
+#endif
 	m_ncompress = n;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SetAsyncWriting(bool b)
+{
+	m_ar.SetAsyncWriting(b);
+}
+
 //-----------------------------------------------------------------------------
 //! set the version string
 void FEBioPlotFile::SetSoftwareString(const std::string& softwareString)
@@ -722,6 +732,8 @@ bool FEBioPlotFile::Open(FEModel &fem, const char *szfile)
 		if (WriteRoot(fem) == false) return false;
 
 		// write the mesh section
+		// (in block compressed files, all sections after the root section are compressed)
+		if (m_ncompress == FileStream::COMPRESS_BLOCKS) m_ar.SetCompression(m_ncompress);
 		if (WriteMeshSection(fem) == false) return false;
 	}
 	catch (...)
@@ -763,7 +775,7 @@ bool FEBioPlotFile::WriteRoot(FEModel& fem)
 bool FEBioPlotFile::WriteHeader(FEModel& fem)
 {
 	// setup the header
-	unsigned int nversion = PLT_VERSION;
+	unsigned int nversion = (m_ncompress == FileStream::COMPRESS_BLOCKS ? PLT_VERSION_BLOCKS : PLT_VERSION);
 
 	// output header
 	m_ar.WriteChunk(PLT_HDR_VERSION, nversion);
@@ -1693,38 +1705,116 @@ void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
 
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::Append(FEModel& fem, const char *szfile)
+{
+	// read the root section
+	bool bok = OpenForReading(szfile);
+
+	// close it again ...
+	m_ar.Close();
+
+	// rebuild the surface table
+	BuildSurfaceTable();
+
+	// ... and open for appending
+	if (bok) return m_ar.Append(szfile);
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioPlotFile::OpenForReading(const char* szfile)
 {
 	// try to open the file
 	if (m_ar.Open(szfile) == false) return false;
 
 	// open the root element
-	m_ar.OpenChunk();
+	if (m_ar.OpenChunk() != IO_OK) return false;
 	unsigned int nid = m_ar.GetChunkID();
 	if (nid != PLT_ROOT) return false;
 
-	bool bok = false;
+	bool bhdr = false, bdic = false;
 	while (m_ar.OpenChunk() == IO_OK)
 	{
 		nid = m_ar.GetChunkID();
-		if (nid == PLT_DICTIONARY)
+		if (nid == PLT_HEADER)
+		{
+			// read the header
+			if (ReadHeader() == false) return false;
+			bhdr = true;
+		}
+		else if (nid == PLT_DICTIONARY)
 		{
 			// read the dictionary
-			bok = ReadDictionary();
-			break;
+			if (ReadDictionary() == false) return false;
+			bdic = true;
 		}
 		m_ar.CloseChunk();
 	}
+	m_ar.CloseChunk();
 
-	// close it again ...
-	m_ar.Close();
+	return (bhdr && bdic);
+}
 
-	// rebuild the surface table
-	BuildSurfaceTable();
+//-----------------------------------------------------------------------------
+bool FEBioPlotFile::ReadState(float& time)
+{
+	// stream compressed files can only be read sequentially as a whole
+	if (m_ncompress == FileStream::COMPRESS_STREAM) return false;
 
-	// ... and open for appending
-	if (bok) return m_ar.Append(szfile);
+	while (true)
+	{
+		// (the first call clears the end flag of the previous section)
+		int nret = m_ar.OpenChunk();
+		if (nret == IO_END) nret = m_ar.OpenChunk();
+		if (nret != IO_OK) return false;
 
-	return false;
+		if (m_ar.GetChunkID() == PLT_STATE)
+		{
+			bool bok = false;
+			while (m_ar.OpenChunk() == IO_OK)
+			{
+				if (m_ar.GetChunkID() == PLT_STATE_HEADER)
+				{
+					while (m_ar.OpenChunk() == IO_OK)
+					{
+						if (m_ar.GetChunkID() == PLT_STATE_HDR_TIME) bok = (m_ar.read(time) == IO_OK);
+						m_ar.CloseChunk();
+					}
+				}
+				m_ar.CloseChunk();
+			}
+			m_ar.CloseChunk();
+			return bok;
+		}
+
+		// skip mesh sections
+		m_ar.CloseChunk();
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioPlotFile::ReadHeader()
+{
+	unsigned int nversion = 0;
+	int ncompress = 0;
+	while (m_ar.OpenChunk() == IO_OK)
+	{
+		unsigned int nid = m_ar.GetChunkID();
+		if      (nid == PLT_HDR_VERSION    ) m_ar.read(nversion);
+		else if (nid == PLT_HDR_COMPRESSION) m_ar.read(ncompress);
+		m_ar.CloseChunk();
+	}
+
+	// we can't append to files of a newer version
+	if (nversion > PLT_VERSION_BLOCKS) return false;
+
+	// the appended states must use the same compression as the rest of the file
+	m_ncompress = ncompress;
+
+	// in block compressed files, the sections after the root section are compressed
+	m_ar.SetBlockCompressed((nversion >= PLT_VERSION_BLOCKS) && (ncompress == FileStream::COMPRESS_BLOCKS));
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -45,7 +45,9 @@ class FEBioPlotFile : public PlotFile
 {
 public:
 	// file version
-	enum { PLT_VERSION = 0x0031 };
+	// Files that use block compression (compression level 2) get a higher version
+	// number, since readers of the older version cannot read the states.
+	enum { PLT_VERSION = 0x0031, PLT_VERSION_BLOCKS = 0x0032 };
 
 	// file tags
 	enum { 
@@ -280,6 +282,13 @@ public:
 	//! Open for appending
 	bool Append(FEModel& fem, const char* szfile);
 
+	//! Open a plot file for reading. This reads the root section (header and dictionary).
+	bool OpenForReading(const char* szfile);
+
+	//! Read the next state of a file opened with OpenForReading. Returns false if there 
+	//! are no more states. (Files with stream compression cannot be read.)
+	bool ReadState(float& time);
+
 	//! Write current FE state to plot database
 	bool Write(FEModel& fem, float ftime, int flag = 0);
 
@@ -288,9 +297,12 @@ public:
 	bool AddVariable(const char* sz);
 	bool AddVariable(const char* sz, vector<int>& item, const char* szdom = "");
 
-	//! Set the compression level
+	//! Set the compression level (0 = none, 1 = zlib stream, 2 = zlib blocks)
 	void SetCompression(int n);
 
+	//! Write the states on a background thread
+	void SetAsyncWriting(bool b);
+
 	//! see if the plot file is valid
 	virtual bool IsValid() const;
 
@@ -348,6 +360,7 @@ protected:
 	void WriteMeshState(FEMesh& mesh);
 
 protected:
+	bool ReadHeader();
 	bool ReadDictionary();
 	bool ReadDicList();
 	void BuildSurfaceTable();
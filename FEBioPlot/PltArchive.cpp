@@ -29,15 +29,21 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "PltArchive.h"
 #include <assert.h>
+#include <algorithm>
 
 #ifdef HAVE_ZLIB
 #include "zlib.h"
-static z_stream strm;
+#endif
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
 //=============================================================================
 // FileStream
 //=============================================================================
+// flag in the block size table that marks blocks that are stored uncompressed
+static const unsigned long long BLOCK_STORED = (1ULL << 63);
+
 FileStream::FileStream()
 {
 	m_bufsize = 262144;	// = 256K
@@ -45,6 +51,15 @@ FileStream::FileStream()
 	m_buf  = new unsigned char[m_bufsize];
 	m_pout = new unsigned char[m_bufsize];
 	m_ncompress = 0;
+	m_bblocks = false;
+	m_nthreads = 0;
+	m_rpos = 0;
+	m_fp = 0;
+#ifdef HAVE_ZLIB
+	m_strm = new z_stream;
+#else
+	m_strm = 0;
+#endif
 }
 
 FileStream::~FileStream()
@@ -54,6 +69,10 @@ FileStream::~FileStream()
 	delete [] m_pout;
 	m_buf = 0;
 	m_pout = 0;
+#ifdef HAVE_ZLIB
+	delete (z_stream*) m_strm;
+#endif
+	m_strm = 0;
 }
 
 bool FileStream::Open(const char* szfile)
@@ -84,13 +103,23 @@ void FileStream::Close()
 void FileStream::BeginStreaming()
 {
 #ifdef HAVE_ZLIB
-	if (m_ncompress)
+	z_stream& strm = *((z_stream*) m_strm);
+	if (m_ncompress == COMPRESS_STREAM)
 	{
 		strm.zalloc = Z_NULL;
 		strm.zfree = Z_NULL;
 		strm.opaque = Z_NULL;
 		deflateInit(&strm, -1);
 	}
+	else if (m_ncompress == COMPRESS_BLOCKS)
+	{
+		// write any data that is still in the buffer uncompressed
+		if (m_current > 0) Flush();
+
+		// from now on, collect the data so it can be compressed in blocks
+		m_data.clear();
+		m_bblocks = true;
+	}
 #endif
 }
 
@@ -98,7 +127,15 @@ void FileStream::EndStreaming()
 {
 	Flush();
 #ifdef HAVE_ZLIB
-	if (m_ncompress)
+	if (m_bblocks)
+	{
+		WriteCompressedBlocks();
+		m_bblocks = false;
+		return;
+	}
+
+	z_stream& strm = *((z_stream*) m_strm);
+	if (m_ncompress == COMPRESS_STREAM)
 	{
 		strm.avail_in = 0;
 		strm.next_in = 0;
@@ -149,7 +186,15 @@ void FileStream::Write(void* pd, size_t Size, size_t Count)
 void FileStream::Flush()
 {
 #ifdef HAVE_ZLIB
-	if (m_ncompress)
+	z_stream& strm = *((z_stream*) m_strm);
+	if (m_bblocks)
+	{
+		// collect the data; it is compressed in EndStreaming
+		m_data.insert(m_data.end(), m_buf, m_buf + m_current);
+		m_current = 0;
+		return;
+	}
+	else if (m_ncompress == COMPRESS_STREAM)
 	{
 		strm.avail_in = m_current;
 		strm.next_in = m_buf;
@@ -181,18 +226,154 @@ void FileStream::Flush()
 	m_current = 0;
 }
 
+void FileStream::WriteCompressedBlocks()
+{
+#ifdef HAVE_ZLIB
+	const size_t N = m_data.size();
+	const size_t B = COMPRESS_BLOCK_SIZE;
+	const int nblocks = (int)((N + B - 1) / B);
+
+	// compress all blocks independently
+	// If a block cannot be compressed, it is stored as is.
+	vector< vector<unsigned char> > out(nblocks);
+	vector<unsigned long long> csize(nblocks, 0);
+	int nthreads = 1;
+#ifdef _OPENMP
+	nthreads = (m_nthreads > 0 ? m_nthreads : omp_get_max_threads());
+#endif
+	#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+	for (int i = 0; i < nblocks; ++i)
+	{
+		size_t n0 = (size_t)i*B;
+		uLong nsrc = (uLong) std::min(B, N - n0);
+		uLongf ndst = compressBound(nsrc);
+		out[i].resize(ndst);
+		int ret = compress(&(out[i])[0], &ndst, &m_data[n0], nsrc);
+		if (ret == Z_OK) csize[i] = ndst;
+		else
+		{
+			out[i].assign(m_data.begin() + n0, m_data.begin() + n0 + nsrc);
+			csize[i] = nsrc | BLOCK_STORED;
+		}
+	}
+
+	// write the block table
+	unsigned long long hdr[3] = { (unsigned long long) nblocks, (unsigned long long) B, (unsigned long long) N };
+	fwrite(hdr, sizeof(unsigned long long), 3, m_fp);
+	if (nblocks > 0) fwrite(&csize[0], sizeof(unsigned long long), nblocks, m_fp);
+
+	// write the blocks
+	for (int i = 0; i < nblocks; ++i)
+	{
+		size_t n = (size_t)(csize[i] & ~BLOCK_STORED);
+		if (n > 0) fwrite(&(out[i])[0], 1, n, m_fp);
+	}
+	fflush(m_fp);
+
+	m_data.clear();
+#endif
+}
+
+bool FileStream::ReadCompressedBlocks(std::vector<unsigned char>& data)
+{
+#ifdef HAVE_ZLIB
+	// read the block table
+	unsigned long long hdr[3];
+	if (fread(hdr, sizeof(unsigned long long), 3, m_fp) != 3) return false;
+	const size_t B = (size_t) hdr[1];
+	const size_t N = (size_t) hdr[2];
+	if ((B == 0) || (hdr[0] != (N + B - 1) / B)) return false;
+	const int nblocks = (int) hdr[0];
+
+	vector<unsigned long long> csize(nblocks);
+	if ((nblocks > 0) && (fread(&csize[0], sizeof(unsigned long long), nblocks, m_fp) != (size_t) nblocks)) return false;
+
+	// read the compressed blocks and record their offsets
+	vector<size_t> offset(nblocks + 1, 0);
+	for (int i = 0; i < nblocks; ++i) offset[i + 1] = offset[i] + (size_t)(csize[i] & ~BLOCK_STORED);
+	vector<unsigned char> in(offset[nblocks]);
+	if ((in.empty() == false) && (fread(&in[0], 1, in.size(), m_fp) != in.size())) return false;
+
+	// decompress the blocks in parallel
+	data.resize(N);
+	bool bok = true;
+	#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < nblocks; ++i)
+	{
+		size_t n0 = (size_t)i*B;
+		uLongf nexp = (uLongf) std::min(B, N - n0);
+		uLongf ndst = nexp;
+		size_t nsrc = offset[i + 1] - offset[i];
+		bool blockOk = true;
+		if (csize[i] & BLOCK_STORED)
+		{
+			if (nsrc == nexp) memcpy(&data[n0], &in[offset[i]], nsrc);
+			else blockOk = false;
+		}
+		else
+		{
+			int ret = uncompress(&data[n0], &ndst, &in[offset[i]], (uLong) nsrc);
+			blockOk = ((ret == Z_OK) && (ndst == nexp));
+		}
+		if (blockOk == false)
+		{
+			#pragma omp critical
+			bok = false;
+		}
+	}
+	return bok;
+#else
+	return false;
+#endif
+}
+
+bool FileStream::BeginBlockReading()
+{
+	m_rpos = 0;
+	m_bblocks = ReadCompressedBlocks(m_data);
+	if (m_bblocks == false) m_data.clear();
+	return m_bblocks;
+}
+
+void FileStream::EndBlockReading()
+{
+	m_bblocks = false;
+	m_data.clear();
+	m_rpos = 0;
+}
+
 size_t FileStream::read(void* pd, size_t Size, size_t Count)
 {
+	if (m_bblocks)
+	{
+		// read from the decompressed data
+		size_t nleft = (m_rpos < m_data.size() ? m_data.size() - m_rpos : 0);
+		size_t n = (Size > 0 ? std::min(Count, nleft / Size) : 0);
+		if (n > 0) memcpy(pd, &m_data[m_rpos], n*Size);
+		m_rpos += n*Size;
+		return n;
+	}
 	return fread(pd, Size, Count, m_fp);
 }
 
 long FileStream::tell()
 {
+	if (m_bblocks) return (long) m_rpos;
 	return ftell(m_fp);
 }
 
 void FileStream::seek(long noff, int norigin)
 {
+	if (m_bblocks)
+	{
+		switch (norigin)
+		{
+		case SEEK_SET: m_rpos = noff; break;
+		case SEEK_CUR: m_rpos += noff; break;
+		case SEEK_END: m_rpos = m_data.size() + noff; break;
+		}
+		return;
+	}
 	fseek(m_fp, noff, norigin);
 }
 
@@ -207,6 +388,14 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+	m_bend = false;
+	m_bblocks = false;
+
+	m_basync = false;
+	m_pending = 0;
+	m_pendingCompression = 0;
+	m_bstop = false;
 }
 
 PltArchive::~PltArchive()
@@ -219,6 +408,9 @@ void PltArchive::Close()
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+
+		// make sure all data is written before the file is closed
+		StopWriter();
 	}
 	else 
 	{
@@ -237,22 +429,93 @@ void PltArchive::Close()
 
 void PltArchive::SetCompression(int n)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	// This is applied when the chunk tree is written, since in asynchronous mode
+	// the file stream may still be in use by the writer thread.
+	m_ncompress = n;
+}
+
+void PltArchive::SetAsyncWriting(bool b)
+{
+	// the writer thread is started when the first tree is flushed
+	if (b == false) StopWriter();
+	m_basync = b;
 }
 
 void PltArchive::Flush()
 {
 	if (m_fp && m_pRoot)
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		if (m_basync)
+		{
+			// start the writer thread if needed
+			if (m_writer.joinable() == false)
+			{
+				m_bstop = false;
+				m_writer = std::thread(&PltArchive::WriterThread, this);
+			}
+
+			// wait until the writer picked up the previous tree and queue this one
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this]() { return (m_pending == 0); });
+			m_pending = m_pRoot;
+			m_pendingCompression = m_ncompress;
+			m_cv.notify_all();
+		}
+		else
+		{
+			WriteTree(m_pRoot, m_ncompress);
+			delete m_pRoot;
+		}
 	}
-	delete m_pRoot;
+	else delete m_pRoot;
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
 
+void PltArchive::WriteTree(OBranch* root, int ncompress)
+{
+	m_fp->SetCompression(ncompress);
+	m_fp->SetCompressionThreads(m_basync ? 1 : 0);
+	m_fp->BeginStreaming();
+	root->Write(m_fp);
+	m_fp->EndStreaming();
+}
+
+void PltArchive::WriterThread()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_cv.wait(lock, [this]() { return (m_pending || m_bstop); });
+
+		// drain the queue before stopping
+		if (m_pending == 0) break;
+
+		OBranch* root = m_pending;
+		int ncompress = m_pendingCompression;
+		m_pending = 0;
+		m_cv.notify_all();
+
+		// do the actual work without holding the lock
+		lock.unlock();
+		WriteTree(root, ncompress);
+		delete root;
+		lock.lock();
+	}
+}
+
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable() == false) return;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bstop = true;
+	}
+	m_cv.notify_all();
+	m_writer.join();
+	m_bstop = false;
+}
+
 bool PltArchive::Create(const char* szfile)
 {
 	// attempt to create the file
@@ -317,6 +580,7 @@ bool PltArchive::Open(const char* szfile)
 
 	m_bSaving = false;
 	m_bend = false;
+	m_bblocks = false;
 	
 	return true;
 }
@@ -341,11 +605,17 @@ int PltArchive::OpenChunk()
 		return IO_END;
 	}
 
+	// a block compressed top-level chunk needs to be decompressed first
+	if (m_bblocks && m_Chunk.empty())
+	{
+		if (m_fp->BeginBlockReading() == false) return IO_END;
+	}
+
 	// create a new chunk
 	CHUNK* pc = new CHUNK;
 
-	// read the chunk ID
-	read(pc->id);
+	// read the chunk ID (this fails at the end of the file)
+	if (read(pc->id) != IO_OK) { delete pc; return IO_END; }
 
 	// read the chunk size
 	read(pc->nsize);
@@ -388,6 +658,9 @@ void PltArchive::CloseChunk()
 	{
 		// we just deleted the root chunk
 		m_bend = true;
+
+		// we're done with the decompressed data
+		if (m_bblocks) m_fp->EndBlockReading();
 	}
 	else
 	{
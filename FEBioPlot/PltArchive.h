@@ -35,12 +35,35 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 using namespace std;
 
 //-----------------------------------------------------------------------------
 //! helper class for writing buffered data to file
+//! The compression level determines how the data between BeginStreaming and 
+//! EndStreaming is written:
+//! 0 = no compression
+//! 1 = the data is compressed as a single zlib stream
+//! 2 = the data is split in blocks that are compressed independently (and in 
+//!     parallel). The output starts with a table that allows readers to locate
+//!     and decompress the blocks in parallel as well:
+//!       uint64  number of blocks (n)
+//!       uint64  uncompressed block size (all blocks but the last)
+//!       uint64  total uncompressed size
+//!       uint64  compressed size of each block [n]
+//!       the compressed blocks (zlib format)
+//!     If the highest bit of a block's size is set, the block could not be 
+//!     compressed and is stored as is.
 class FileStream
 {
+public:
+	enum { COMPRESS_NONE, COMPRESS_STREAM, COMPRESS_BLOCKS };
+
+	// uncompressed size of blocks for block compression
+	enum { COMPRESS_BLOCK_SIZE = 1048576 };
+
 public:
 	FileStream();
 	~FileStream();
@@ -64,6 +87,22 @@ public:
 
 	void SetCompression(int n) { m_ncompress = n; }
 
+	// Set the max number of threads used for block compression (0 = default)
+	void SetCompressionThreads(int n) { m_nthreads = n; }
+
+	// Read the block compressed data that starts at the current file position and
+	// decompress it in parallel. Returns false if the data could not be read.
+	bool ReadCompressedBlocks(std::vector<unsigned char>& data);
+
+	// Read the next block compressed section. Until EndBlockReading is called, 
+	// read, tell and seek then operate on the decompressed data.
+	bool BeginBlockReading();
+	void EndBlockReading();
+
+private:
+	// compress the collected data in blocks and write to file
+	void WriteCompressedBlocks();
+
 private:
 	FILE*	m_fp;
 	size_t	m_bufsize;		//!< buffer size
@@ -71,6 +110,11 @@ private:
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
 	int		m_ncompress;	//!< compression level
+	bool	m_bblocks;		//!< collecting (writing) or reading block compressed data
+	int		m_nthreads;		//!< max nr of threads for block compression (0 = default)
+	void*	m_strm;			//!< compression stream (z_stream)
+	std::vector<unsigned char>	m_data;	//!< data collected for block compression, or decompressed data
+	size_t	m_rpos;			//!< read position in decompressed data
 };
 
 class OBranch;
@@ -344,17 +388,50 @@ public:
 
 	void SetCompression(int n);
 
+	// In block compressed files, all top-level chunks after the root chunk are block
+	// compressed. When this is turned on (FEBioPlotFile does this when it reads the 
+	// header), each top-level chunk is decompressed when it is opened.
+	void SetBlockCompressed(bool b) { m_bblocks = b; }
+
 	bool IsValid() const { return (m_fp != 0); }
 
+	// In asynchronous mode, completed chunk trees are handed to a background thread
+	// that does the compression and file output, so the caller does not have to wait
+	// for the I/O. At most one tree is queued while the next one is being built.
+	// The background thread compresses on a single thread so that it does not 
+	// compete with the solver for the OpenMP threads.
+	void SetAsyncWriting(bool b);
+
+protected:
+	// write a chunk tree to file
+	void WriteTree(OBranch* root, int ncompress);
+
+	// the background writer thread
+	void WriterThread();
+
+	// stop the background writer thread
+	void StopWriter();
+
 protected:
 	FileStream*	m_fp;		// pointer to file stream
 	bool		m_bSaving;	// read or write mode?
 
 	// write data
-	OBranch*	m_pRoot;	// chunk tree root
-	OBranch*	m_pChunk;	// current chunk
+	OBranch*	m_pRoot;		// chunk tree root
+	OBranch*	m_pChunk;		// current chunk
+	int			m_ncompress;	// compression level for the next chunk tree
+
+	// asynchronous writing
+	bool					m_basync;		// asynchronous writing flag
+	std::thread				m_writer;		// the writer thread
+	std::mutex				m_mutex;		// protects the data below
+	std::condition_variable	m_cv;			// signals changes of the data below
+	OBranch*				m_pending;		// tree waiting to be written
+	int						m_pendingCompression;	// compression level of pending tree
+	bool					m_bstop;		// request the writer to stop
 
 	// read data
 	bool			m_bend;		// chunk end flag
+	bool			m_bblocks;	// top-level chunks are block compressed
 	stack<CHUNK*>	m_Chunk;
 };
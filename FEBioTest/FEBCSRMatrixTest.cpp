@@ -0,0 +1,137 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEBCSRMatrixTest.h"
+#include <NumCore/BCSRMatrix.h>
+#include <NumCore/CompactUnSymmMatrix.h>
+#include <FECore/MatrixProfile.h>
+#include <FECore/matrix.h>
+#include <FECore/log.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FEBCSRMatrixTest::FEBCSRMatrixTest(FEModel* pfem) : FECoreTask(pfem)
+{
+}
+
+//-----------------------------------------------------------------------------
+// initialize the diagnostic
+bool FEBCSRMatrixTest::Init(const char* sz)
+{
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// run the diagnostic
+bool FEBCSRMatrixTest::Run()
+{
+	FEModel* fem = GetFEModel();
+
+	// Setup a chain of nodes with three dofs. Every third node has a fixed
+	// dof, so that the blocks have different sizes.
+	const int nodes = 50;
+	vector<int> id(3 * nodes, -1);
+	vector<int> bp(1, 0);
+	int neq = 0;
+	for (int i = 0; i < nodes; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			if ((i % 3 != 2) || (j != 1)) id[3 * i + j] = neq++;
+		}
+		bp.push_back(neq);
+	}
+
+	// each element connects two neighboring nodes
+	const int elems = nodes - 1;
+	vector< vector<int> > LM(elems);
+	for (int i = 0; i < elems; ++i)
+	{
+		LM[i].assign(id.begin() + 3 * i, id.begin() + 3 * i + 6);
+	}
+
+	SparseMatrixProfile mp(neq, neq);
+	mp.UpdateProfile(LM, elems);
+
+	// assemble the same (unsymmetric) element matrices into both formats
+	BCSRMatrix K;
+	K.SetBlockPartition(bp);
+	K.Create(mp);
+	K.Zero();
+
+	CRSSparseMatrix Kref(0);
+	Kref.Create(mp);
+	Kref.Zero();
+
+	matrix ke(6, 6);
+	for (int n = 0; n < elems; ++n)
+	{
+		for (int i = 0; i < 6; ++i)
+			for (int j = 0; j < 6; ++j)
+			{
+				ke[i][j] = 1.0 / (1.0 + i + j) + 0.1*(i - j) + 0.01*n + (i == j ? 4.0 : 0.0);
+			}
+
+		K.Assemble(ke, LM[n]);
+		Kref.Assemble(ke, LM[n]);
+	}
+
+	// convert to 0- and 1-based compressed row format
+	CRSSparseMatrix K0(0), K1(1);
+	K.ToCRS(K0);
+	K.ToCRS(K1);
+
+	// compare the matrix-vector products
+	vector<double> x(neq), y(neq), y0(neq), y1(neq), yref(neq);
+	for (int i = 0; i < neq; ++i) x[i] = sin(i + 1.0);
+
+	if ((K.mult_vector(&x[0], &y[0]) == false) ||
+		(K0.mult_vector(&x[0], &y0[0]) == false) ||
+		(K1.mult_vector(&x[0], &y1[0]) == false) ||
+		(Kref.mult_vector(&x[0], &yref[0]) == false))
+	{
+		feLogEx(fem, "Matrix-vector product failed.");
+		return false;
+	}
+
+	double norm = 0.0, err = 0.0;
+	for (int i = 0; i < neq; ++i)
+	{
+		norm += yref[i] * yref[i];
+		err = fmax(err, fabs(y[i] - yref[i]));
+		err = fmax(err, fabs(y0[i] - yref[i]));
+		err = fmax(err, fabs(y1[i] - yref[i]));
+	}
+	norm = sqrt(norm);
+
+	feLogEx(fem, "Matrix: %d equations, %d blocks (%d nonzeroes)", neq, K.Blocks(), K.NonZeroes());
+	feLogEx(fem, "Max difference: %lg", err);
+
+	return ((K0.NonZeroes() == K.NonZeroes()) && (K1.NonZeroes() == K.NonZeroes()) && (err <= 1e-12*norm));
+}
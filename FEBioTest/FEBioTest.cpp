@@ -35,6 +35,9 @@ SOFTWARE.*/
 #include "FEJFNKTangentDiagnostic.h"
 #include "FEBioEigenSolver.h"
 #include "FEResetTest.h"
+#include "FEPlotFileTest.h"
+#include "FEElementSearchTest.h"
+#include "FEBCSRMatrixTest.h"
 
 namespace FEBioTest
 {
@@ -46,5 +49,8 @@ void InitModule()
 	REGISTER_FECORE_CLASS(FEJFNKTangentDiagnostic, "jfnk tangent test");
 	REGISTER_FECORE_CLASS(FEBioEigenSolver, "eigen");
 	REGISTER_FECORE_CLASS(FEResetTest, "reset_test");
+	REGISTER_FECORE_CLASS(FEPlotFileTest, "plot_test");
+	REGISTER_FECORE_CLASS(FEElementSearchTest, "element_search_test");
+	REGISTER_FECORE_CLASS(FEBCSRMatrixTest, "bcsr_test");
 }
 }
@@ -0,0 +1,139 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEElementSearchTest.h"
+#include <FEBioLib/FEBioModel.h>
+#include <FECore/FESolidDomain.h>
+#include <FECore/FEBoundingBox.h>
+#include <FECore/log.h>
+
+//-----------------------------------------------------------------------------
+FEElementSearchTest::FEElementSearchTest(FEModel* pfem) : FECoreTask(pfem)
+{
+}
+
+//-----------------------------------------------------------------------------
+// initialize the diagnostic
+bool FEElementSearchTest::Init(const char* sz)
+{
+	FEBioModel& fem = dynamic_cast<FEBioModel&>(*GetFEModel());
+
+	// do the FE initialization
+	return fem.Init();
+}
+
+//-----------------------------------------------------------------------------
+// run the diagnostic
+bool FEElementSearchTest::Run()
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+	FEMesh& mesh = fem->GetMesh();
+
+	// collect the integration points of all solid elements
+	vector<vec3d> y;
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		if (dom.Class() != FE_DOMAIN_SOLID) continue;
+		FESolidDomain& sd = static_cast<FESolidDomain&>(dom);
+		for (int j = 0; j < sd.Elements(); ++j)
+		{
+			FESolidElement& el = sd.Element(j);
+			for (int n = 0; n < el.GaussPoints(); ++n)
+			{
+				double* H = el.H(n);
+				vec3d x(0, 0, 0);
+				for (int k = 0; k < el.Nodes(); ++k) x += mesh.Node(el.m_node[k]).m_rt*H[k];
+				y.push_back(x);
+			}
+		}
+	}
+
+	if (y.empty())
+	{
+		feLogEx(fem, "The model has no solid elements.");
+		return false;
+	}
+
+	// add a point that lies outside the mesh
+	FEBoundingBox box(y[0]);
+	for (size_t i = 1; i < y.size(); ++i) box.add(y[i]);
+	y.push_back(box.center() + vec3d(1, 1, 1)*(box.radius() + 1.0));
+
+	// locate all points at once
+	vector<FESolidElement*> el;
+	vector<vec3d> r;
+	mesh.FindSolidElements(y, el, r);
+
+	// compare with the element search of the domains
+	for (size_t i = 0; i < y.size(); ++i)
+	{
+		double q[3] = { 0, 0, 0 };
+		FESolidElement* pe = 0;
+		for (int j = 0; j < mesh.Domains(); ++j)
+		{
+			FEDomain& dom = mesh.Domain(j);
+			if (dom.Class() != FE_DOMAIN_SOLID) continue;
+			pe = static_cast<FESolidDomain&>(dom).FindElement(y[i], q);
+			if (pe) break;
+		}
+
+		if (pe != el[i])
+		{
+			feLogEx(fem, "Point %d was located in different elements.", (int)i);
+			return false;
+		}
+
+		vec3d d = r[i] - vec3d(q[0], q[1], q[2]);
+		if (pe && (d.norm() > 1e-12))
+		{
+			feLogEx(fem, "Point %d has different isoparametric coordinates.", (int)i);
+			return false;
+		}
+	}
+
+	// the integration points must be found, but not the point outside the mesh
+	for (size_t i = 0; i < y.size() - 1; ++i)
+	{
+		if (el[i] == 0)
+		{
+			feLogEx(fem, "Point %d was not found.", (int)i);
+			return false;
+		}
+	}
+	if (el.back() != 0)
+	{
+		feLogEx(fem, "A point outside the mesh was found.");
+		return false;
+	}
+
+	feLogEx(fem, "Located %d points.", (int)y.size());
+
+	return true;
+}
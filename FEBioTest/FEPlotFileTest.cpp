@@ -0,0 +1,107 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEPlotFileTest.h"
+#include <FEBioLib/FEBioModel.h>
+#include <FEBioPlot/FEBioPlotFile.h>
+#include <FECore/log.h>
+
+//-----------------------------------------------------------------------------
+FEPlotFileTest::FEPlotFileTest(FEModel* pfem) : FECoreTask(pfem)
+{
+}
+
+//-----------------------------------------------------------------------------
+// initialize the diagnostic
+bool FEPlotFileTest::Init(const char* sz)
+{
+	FEBioModel& fem = dynamic_cast<FEBioModel&>(*GetFEModel());
+
+	// do the FE initialization
+	return fem.Init();
+}
+
+//-----------------------------------------------------------------------------
+// run the diagnostic
+bool FEPlotFileTest::Run()
+{
+	if (RunTest(FileStream::COMPRESS_NONE  ) == false) return false;
+	if (RunTest(FileStream::COMPRESS_BLOCKS) == false) return false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotFileTest::RunTest(int ncompress)
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+	std::string file = fem->GetPlotFileName() + ".test";
+	const int states = 5;
+
+	// write a few states
+	FEBioPlotFile out(*fem);
+	out.SetCompression(ncompress);
+	out.AddVariable("displacement");
+	if (out.Open(*fem, file.c_str()) == false)
+	{
+		feLogEx(fem, "Failed to create plot file %s.", file.c_str());
+		return false;
+	}
+	for (int i = 0; i < states; ++i) out.Write(*fem, (float)i);
+	out.Close();
+
+	// read them back
+	FEBioPlotFile in(*fem);
+	if (in.OpenForReading(file.c_str()) == false)
+	{
+		feLogEx(fem, "Failed to open plot file %s.", file.c_str());
+		return false;
+	}
+
+	int n = 0;
+	float time = 0.f;
+	while (in.ReadState(time))
+	{
+		if (time != (float)n)
+		{
+			feLogEx(fem, "Plot file state %d has the wrong time.", n);
+			return false;
+		}
+		n++;
+	}
+	in.Close();
+	remove(file.c_str());
+
+	if (n != states)
+	{
+		feLogEx(fem, "Read %d of %d states (compression = %d).", n, states, ncompress);
+		return false;
+	}
+
+	return true;
+}
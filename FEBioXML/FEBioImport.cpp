@@ -273,6 +273,7 @@ bool FEBioImport::Load(FEModel& fem, const char* szfile)
 	m_szplot_type[0] = 0;
 	m_plot.clear();
 	m_nplot_compression = 0;
+	m_bplot_async = false;
 
 	m_data.clear();
 
@@ -506,6 +507,12 @@ void FEBioImport::SetPlotCompression(int n)
 	m_nplot_compression = n;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioImport::SetPlotAsyncWriting(bool b)
+{
+	m_bplot_async = b;
+}
+
 //-----------------------------------------------------------------------------
 // This tag parses a node set.
 FENodeSet* FEBioImport::ParseNodeSet(XMLTag& tag, const char* szatt)
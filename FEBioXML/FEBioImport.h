@@ -174,6 +174,8 @@ public:
     void AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom = "");
 
 	void SetPlotCompression(int n);
+
+	void SetPlotAsyncWriting(bool b);
     
 	void AddDataRecord(DataRecord* pd);
 
@@ -196,6 +198,7 @@ public:
 	char					m_szplot_type[256];
 	vector<PlotVariable>	m_plot;
 	int						m_nplot_compression;
+	bool					m_bplot_async;
 
 	vector<DataRecord*>		m_data;
 };
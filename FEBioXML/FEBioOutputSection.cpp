@@ -397,6 +397,12 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 				tag.value(ncomp);
 				GetFEBioImport()->SetPlotCompression(ncomp);
 			}
+			else if (tag=="async")
+			{
+				bool b;
+				tag.value(b);
+				GetFEBioImport()->SetPlotAsyncWriting(b);
+			}
 			++tag;
 		}
 		while (!tag.isend());
@@ -64,6 +64,7 @@ bool BFGSSolver::Init()
 	m_D.resize(neq);
 	m_G.resize(neq);
 	m_H.resize(neq);
+	tmp.resize(neq);
 
 	m_neq = neq;
 	m_nups = 0;
@@ -144,7 +145,7 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	// make sure we need to do work
 	if (m_neq ==0) return;
 
-	// create temporary storage
+	// copy the right-hand side (tmp was allocated in Init)
 	tmp = b;
 
 	// number of updates can be larger than buffer size, so clamp it
@@ -158,18 +159,17 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop over all update vectors
+	// Each pass applies the previous update and evaluates the dot product for the next one.
+	double* t = &tmp[0];
+	const double* vp = nullptr;
+	double wr = 0;
 	for (int i=nups-1; i>=0; --i)
 	{
 		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double wr = 0;
-		for (int j = 0; j<m_neq; j++) wr += wi[j] * tmp[j];
-
-		for (int j = 0; j<m_neq; j++) tmp[j] += vi[j] * wr;
+		wr = vadds_dot(t, vp, wr, m_W[n], m_neq);
+		vp = m_V[n];
 	}
+	if (vp) vadds_dot(t, vp, wr, nullptr, m_neq);
 
 	// perform a backsubstitution
 	if (m_plinsolve->BackSolve(x, tmp) == false)
@@ -178,16 +178,14 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop again over all update vectors
+	double* px = &x[0];
+	const double* wp = nullptr;
+	double vr = 0;
 	for (int i = 0; i<nups; ++i)
 	{
 		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double vr = 0;
-		for (int j = 0; j<m_neq; ++j) vr += vi[j] * x[j];
-
-		for (int j = 0; j<m_neq; ++j) x[j] += wi[j] * vr;
+		vr = vadds_dot(px, wp, vr, m_V[n], m_neq);
+		wp = m_W[n];
 	}
+	if (wp) vadds_dot(px, wp, vr, nullptr, m_neq);
 }
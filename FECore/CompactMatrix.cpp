@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "CompactMatrix.h"
 #include <assert.h>
+#include <algorithm>
 
 //=============================================================================
 // CompactMatrix
@@ -128,3 +129,15 @@ int CompactMatrix::bandWidth()
 
 	return kmax;
 }
+
+//-----------------------------------------------------------------------------
+//! Find the offset into the values array of entry k of column (or row) n. 
+//! This assumes that the indices are ordered. Returns -1 if the entry is not found.
+int CompactMatrix::findOffset(int n, int k) const
+{
+	const int* pi0 = m_pindices + (m_ppointers[n] - m_offset);
+	const int* pi1 = m_pindices + (m_ppointers[n + 1] - m_offset);
+	const int* pk = std::lower_bound(pi0, pi1, k + m_offset);
+	if ((pk == pi1) || (*pk != k + m_offset)) return -1;
+	return (m_ppointers[n] - m_offset) + (int)(pk - pi0);
+}
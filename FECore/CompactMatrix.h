@@ -83,13 +83,14 @@ public:
 	//! calculate bandwidth of matrix
 	int bandWidth();
 
+protected:
+	//! find the offset into the values array of entry k of column (or row) n. Returns -1 if not found.
+	int findOffset(int n, int k) const;
+
 protected:
 	double*	m_pd;			//!< matrix values
 	int*	m_pindices;		//!< indices
 	int*	m_ppointers;	//!< pointers
 	int		m_offset;		//!< adjust array indices for fortran arrays
 	bool	m_bdel;			//!< delete data arrays in destructor
-
-protected:
-	std::vector<int>	P;
 };
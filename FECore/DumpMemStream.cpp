@@ -56,6 +56,13 @@ void DumpMemStream::clear()
 	Open(true, true);
 }
 
+//-----------------------------------------------------------------------------
+void DumpMemStream::reset()
+{
+	m_nsize = 0;
+	Open(true, true);
+}
+
 //-----------------------------------------------------------------------------
 void DumpMemStream::Open(bool bsave, bool bshallow)
 {
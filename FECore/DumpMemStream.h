@@ -45,6 +45,10 @@ public: // overloaded from base class
 	void clear();
 	void Open(bool bsave, bool bshallow);
 
+	//! Empty the stream and reopen it for writing, but keep the allocated buffer. 
+	//! Use this instead of clear when the stream is refilled with (roughly) the same data. 
+	void reset();
+
 	size_t size() const { return m_nsize; }
 	size_t reserved() const { return m_nreserved; }
 	bool EndOfStream() const;
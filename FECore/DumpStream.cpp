@@ -34,6 +34,7 @@ DumpStream::DumpStream(FEModel& fem) : m_fem(fem)
 {
 	m_bsave = false;
 	m_bshallow = false;
+	m_bcheckpoint = false;
 	m_bytes_serialized = 0;
 	m_ptr_lock = false;
 
@@ -141,6 +141,14 @@ public:
 	//! See if shallow flag is set
 	bool IsShallow() const;
 
+	//! Set the checkpoint flag. This is used by FECheckpoint, which copies the nodal
+	//! data and the state of material points that support FEMaterialPoint::CopyState
+	//! to separate buffers, so these do not need to be serialized.
+	void SetCheckpoint(bool b) { m_bcheckpoint = b; }
+
+	//! See if the checkpoint flag is set
+	bool IsCheckpoint() const { return m_bcheckpoint; }
+
 	// open the stream
 	virtual void Open(bool bsave, bool bshallow);
 
@@ -213,6 +221,10 @@ public: // input operators
 	template <typename T> DumpStream& read_raw(T& o);
 
 private:
+	// stream arrays of fixed-size types in one block (when no type info is needed)
+	template <typename T> DumpStream& write_array(std::vector<T>& o);
+	template <typename T> DumpStream& read_array(std::vector<T>& o);
+
 	int FindPointer(void* p);
 	int FindPointer(int id);
 	void AddPointer(void* p);
@@ -240,6 +252,7 @@ private:
 private:
 	bool		m_bsave;	//!< true if output stream, false for input stream
 	bool		m_bshallow;	//!< if true only shallow data needs to be serialized
+	bool		m_bcheckpoint;	//!< if true, node and checkpointed material point data is not serialized
 	bool		m_btypeInfo;	//!< write/read type info
 	FEModel&	m_fem;		//!< the FE Model that is being serialized
 
@@ -358,6 +371,44 @@ template <typename T> inline DumpStream& DumpStream::operator >> (std::vector<T>
 	return This;
 }
 
+template <typename T> inline DumpStream& DumpStream::write_array(std::vector<T>& o)
+{
+	if (m_btypeInfo) writeType(TypeID::TYPE_UNKNOWN);
+	int N = (int)o.size();
+	write(&N, sizeof(int), 1);
+	if (m_btypeInfo)
+	{
+		for (int i = 0; i<N; ++i) write_raw(o[i]);
+	}
+	else if (N > 0) m_bytes_serialized += write(&o[0], sizeof(T), N);
+	return *this;
+}
+
+template <typename T> inline DumpStream& DumpStream::read_array(std::vector<T>& o)
+{
+	if (m_btypeInfo) readType(TypeID::TYPE_UNKNOWN);
+	int N;
+	read(&N, sizeof(int), 1);
+	if (N > 0)
+	{
+		o.resize(N);
+		if (m_btypeInfo)
+		{
+			for (int i = 0; i<N; ++i) read_raw(o[i]);
+		}
+		else m_bytes_serialized += read(&o[0], sizeof(T), N);
+	}
+	return *this;
+}
+
+template <> inline DumpStream& DumpStream::operator << (std::vector<int>&    o) { return write_array(o); }
+template <> inline DumpStream& DumpStream::operator << (std::vector<double>& o) { return write_array(o); }
+template <> inline DumpStream& DumpStream::operator << (std::vector<vec3d>&  o) { return write_array(o); }
+
+template <> inline DumpStream& DumpStream::operator >> (std::vector<int>&    o) { return read_array(o); }
+template <> inline DumpStream& DumpStream::operator >> (std::vector<double>& o) { return read_array(o); }
+template <> inline DumpStream& DumpStream::operator >> (std::vector<vec3d>&  o) { return read_array(o); }
+
 template <> inline DumpStream& DumpStream::operator << (std::vector<bool>& o)
 {
 	if (m_btypeInfo) writeType(TypeID::TYPE_UNKNOWN);
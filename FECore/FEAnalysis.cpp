@@ -34,10 +34,11 @@ SOFTWARE.*/
 #include "DOFS.h"
 #include "MatrixProfile.h"
 #include "FEBoundaryCondition.h"
-#include "DumpMemStream.h"
+#include "FECheckpoint.h"
 #include "FELinearConstraintManager.h"
 #include "FEShellDomain.h"
 #include "FEMeshAdaptor.h"
+#include "FEProfiler.h"
 
 REGISTER_SUPER_CLASS(FEAnalysis, FEANALYSIS_ID);
 
@@ -373,8 +374,8 @@ bool FEAnalysis::Solve()
 		if (m_timeController) m_timeController->AutoTimeStep(0);
 	}
 
-	// dump stream for running restarts
-	DumpMemStream dmp(fem);
+	// checkpoint for running restarts
+	FECheckpoint checkpoint(fem);
 
 	// repeat for all timesteps
 	if (m_timeController) m_timeController->m_nretries = 0;
@@ -384,8 +385,8 @@ bool FEAnalysis::Solve()
 		// we need to retry this time step
 		if (m_timeController && (m_timeController->m_maxretries > 0))
 		{ 
-			dmp.clear();
-			fem.Serialize(dmp); 
+			FE_PROFILE("checkpoint");
+			checkpoint.Save();
 		}
 
 		// Inform that the time is about to change. (Plugins can use 
@@ -409,7 +410,11 @@ bool FEAnalysis::Solve()
 		}
 
 		// Solve the time step
-		int ierr = SolveTimeStep();
+		int ierr = 0;
+		{
+			FE_PROFILE("time step");
+			ierr = SolveTimeStep();
+		}
 
 		// see if we want to abort
 		if (ierr == 2) 
@@ -424,6 +429,10 @@ bool FEAnalysis::Solve()
 		m_ntotiter += psolver->m_niter;
 		m_ntotrhs  += psolver->m_nrhs;
 
+		FEProfiler* prof = FEProfiler::GetInstance();
+		prof->AddCount("newton iterations", psolver->m_niter);
+		prof->AddCount("residual evaluations", psolver->m_nrhs);
+
 		// update model's data
 		fem.UpdateModelData();
 
@@ -437,6 +446,7 @@ bool FEAnalysis::Solve()
 
 			// update nr of completed timesteps
 			m_ntimesteps++;
+			prof->AddCount("time steps");
 
 			// call callback function
 			if (fem.DoCallback(CB_MAJOR_ITERS) == false)
@@ -467,8 +477,11 @@ bool FEAnalysis::Solve()
 			if (m_timeController && (m_timeController->m_nretries < m_timeController->m_maxretries))
 			{
 				// restore the previous state
-				dmp.Open(false, true);
-				fem.Serialize(dmp);
+				{
+					FE_PROFILE("checkpoint");
+					checkpoint.Restore();
+				}
+				prof->AddCount("retries");
 				
 				// let's try again
 				m_timeController->Retry();
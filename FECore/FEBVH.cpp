@@ -0,0 +1,166 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEBVH.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// max number of items in a leaf
+#define BVH_LEAF_SIZE	4
+
+//-----------------------------------------------------------------------------
+// grow the box (r0, r1) so that it contains the box (a, b)
+static inline void AddBox(vec3d& r0, vec3d& r1, const vec3d& a, const vec3d& b)
+{
+	if (a.x < r0.x) r0.x = a.x; if (b.x > r1.x) r1.x = b.x;
+	if (a.y < r0.y) r0.y = a.y; if (b.y > r1.y) r1.y = b.y;
+	if (a.z < r0.z) r0.z = a.z; if (b.z > r1.z) r1.z = b.z;
+}
+
+//-----------------------------------------------------------------------------
+FEBVH::FEBVH()
+{
+}
+
+//-----------------------------------------------------------------------------
+FEBVH::~FEBVH()
+{
+}
+
+//-----------------------------------------------------------------------------
+void FEBVH::Build()
+{
+	m_node.clear();
+	m_item.clear();
+
+	int N = Items();
+	if (N == 0) return;
+
+	// item centroids are used for splitting
+	vector<vec3d> c(N);
+	m_item.resize(N);
+	for (int i = 0; i < N; ++i)
+	{
+		vec3d r0, r1;
+		ItemBox(i, r0, r1);
+		c[i] = (r0 + r1)*0.5;
+		m_item[i] = i;
+	}
+
+	// a binary tree with at most BVH_LEAF_SIZE items per leaf has less than 2*N nodes
+	m_node.reserve(2*N);
+	m_node.push_back(NODE());
+	BuildNode(0, 0, N, c);
+}
+
+//-----------------------------------------------------------------------------
+// Recursively build the hierarchy. Children are always stored after their parent.
+void FEBVH::BuildNode(int n, int first, int count, const vector<vec3d>& c)
+{
+	// calculate the bounding box of the items and of their centroids
+	vec3d r0, r1;
+	ItemBox(m_item[first], r0, r1);
+	vec3d c0 = c[m_item[first]], c1 = c0;
+	for (int i = first + 1; i < first + count; ++i)
+	{
+		vec3d a, b;
+		ItemBox(m_item[i], a, b);
+		AddBox(r0, r1, a, b);
+
+		const vec3d& ci = c[m_item[i]];
+		AddBox(c0, c1, ci, ci);
+	}
+
+	NODE& node = m_node[n];
+	node.r0 = r0;
+	node.r1 = r1;
+	node.child = -1;
+	node.first = first;
+	node.count = count;
+	if (count <= BVH_LEAF_SIZE) return;
+
+	// split at the median of the longest axis of the centroid box
+	vec3d d = c1 - c0;
+	int axis = 0;
+	if ((d.y > d.x) && (d.y >= d.z)) axis = 1;
+	else if ((d.z > d.x) && (d.z > d.y)) axis = 2;
+
+	int* pi = &m_item[0];
+	int half = count / 2;
+	nth_element(pi + first, pi + first + half, pi + first + count, [&](int a, int b) {
+		double ca = (axis == 0 ? c[a].x : (axis == 1 ? c[a].y : c[a].z));
+		double cb = (axis == 0 ? c[b].x : (axis == 1 ? c[b].y : c[b].z));
+		return (ca < cb) || ((ca == cb) && (a < b));
+	});
+
+	// create the children (note that this may invalidate the node reference)
+	int child = (int)m_node.size();
+	m_node[n].child = child;
+	m_node[n].count = 0;
+	m_node.push_back(NODE());
+	m_node.push_back(NODE());
+	BuildNode(child    , first       , half        , c);
+	BuildNode(child + 1, first + half, count - half, c);
+}
+
+//-----------------------------------------------------------------------------
+// Update the bounding boxes to the current nodal positions. The topology of 
+// the tree is not changed, so it remains correct, although it may become less
+// efficient for large deformations.
+void FEBVH::Refit()
+{
+	if (m_node.empty()) { Build(); return; }
+
+	// children are stored after their parents, so we can update the boxes
+	// by processing the nodes in reverse order
+	for (int n = (int)m_node.size() - 1; n >= 0; --n)
+	{
+		NODE& node = m_node[n];
+		if (node.child < 0)
+		{
+			ItemBox(m_item[node.first], node.r0, node.r1);
+			for (int i = node.first + 1; i < node.first + node.count; ++i)
+			{
+				vec3d a, b;
+				ItemBox(m_item[i], a, b);
+				AddBox(node.r0, node.r1, a, b);
+			}
+		}
+		else
+		{
+			const NODE& a = m_node[node.child];
+			const NODE& b = m_node[node.child + 1];
+			node.r0 = a.r0; node.r1 = a.r1;
+			AddBox(node.r0, node.r1, b.r0, b.r1);
+		}
+	}
+}
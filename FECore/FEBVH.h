@@ -0,0 +1,80 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "vec3d.h"
+#include <vector>
+#include "fecore_api.h"
+
+//-----------------------------------------------------------------------------
+//! Base class for axis-aligned bounding box hierarchies. Derived classes define
+//! the items (e.g. facets or elements) through their number and bounding boxes,
+//! and implement the queries. The hierarchy is built once and can then be 
+//! refitted to the current nodal positions, which is much cheaper than rebuilding
+//! it. Queries should not modify the hierarchy so they can be called from 
+//! multiple threads.
+class FECORE_API FEBVH
+{
+protected:
+	struct NODE
+	{
+		vec3d	r0, r1;		// bounding box
+		int		child;		// index of first child (second child is child + 1), or -1 for leaves
+		int		first;		// first item in item list (leaves only)
+		int		count;		// number of items (leaves only)
+	};
+
+public:
+	FEBVH();
+	virtual ~FEBVH();
+
+	//! build the hierarchy for the current nodal positions
+	void Build();
+
+	//! update the bounding boxes for the current nodal positions
+	void Refit();
+
+	//! see if the hierarchy was built
+	bool IsValid() const { return (m_node.empty() == false); }
+
+protected:
+	//! number of items
+	virtual int Items() const = 0;
+
+	//! bounding box of an item
+	virtual void ItemBox(int i, vec3d& r0, vec3d& r1) const = 0;
+
+private:
+	void BuildNode(int n, int first, int count, const std::vector<vec3d>& c);
+
+protected:
+	std::vector<NODE>	m_node;		//!< the hierarchy nodes (root is at 0)
+	std::vector<int>	m_item;		//!< item indices, ordered by leaf
+};
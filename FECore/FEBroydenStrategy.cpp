@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FEException.h"
 #include "FENewtonSolver.h"
+#include "vector.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -92,16 +93,7 @@ bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0,
 		int n1 = (m_nups >= m_max_buf_size ? (m_nups) % m_max_buf_size : m_nups);
 
 		// loop over update vectors
-		for (int j = 0; j<nups; ++j)
-		{
-			int n = (n0 + j) % m_max_buf_size;
-
-			double w = 0.0;
-			for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
-
-			double g = m_rho[n] * w;
-			for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
-		}
+		ApplyUpdates(n0, nups);
 
 		// form and store the next update vector
 		double rhoi = 0.0;
@@ -122,6 +114,28 @@ bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0,
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! Apply nups update vectors to q, starting at buffer n0. Each pass over q applies 
+//! the previous update and evaluates the dot product for the next one.
+void FEBroydenStrategy::ApplyUpdates(int n0, int nups)
+{
+	double* q = &m_q[0];
+	const double* dp = nullptr;
+	const double* rp = nullptr;
+	double g = 0.0;
+	for (int j = 0; j<nups; ++j)
+	{
+		int n = (n0 + j) % m_max_buf_size;
+
+		double w = vaddsub_dot(q, dp, rp, g, m_D[n], m_neq);
+
+		g = m_rho[n] * w;
+		dp = m_D[n];
+		rp = m_R[n];
+	}
+	if (dp) vaddsub_dot(q, dp, rp, g, nullptr, m_neq);
+}
+
 //-----------------------------------------------------------------------------
 //! solve the equations
 void FEBroydenStrategy::SolveEquations(vector<double>& x, vector<double>& b)
@@ -154,28 +168,23 @@ void FEBroydenStrategy::SolveEquations(vector<double>& x, vector<double>& b)
 			if (m_plinsolve->BackSolve(m_q, b) == false)
 				throw LinearSolverFailed();
 
-			for (int j = 0; j<nups - 1; ++j)
-			{
-				int n = (n0 + j) % m_max_buf_size;
-
-				double w = 0.0;
-				for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
-
-				double g = m_rho[n] * w;
-				for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
-			}
+			ApplyUpdates(n0, nups - 1);
 
 			m_bnewStep = false;
 		}
 
 		// calculate solution
-		double rho = 0.0;
-		for (int i = 0; i<m_neq; ++i) rho += m_D[n1][i] * m_q[i];
+		double rho = vadds_dot(&m_q[0], nullptr, 0.0, m_D[n1], m_neq);
 		rho *= m_rho[n1];
 
-		for (int i = 0; i<m_neq; ++i)
+		const double* q = &m_q[0];
+		const double* dn = m_D[n1];
+		const double* rn = m_R[n1];
+		const int neq = m_neq;
+#pragma omp parallel for schedule(static) if (neq > 20000)
+		for (int i = 0; i<neq; ++i)
 		{
-			x[i] = m_q[i] + rho*(m_D[n1][i] - m_R[n1][i]);
+			x[i] = q[i] + rho*(dn[i] - rn[i]);
 		}
 	}
 }
@@ -50,6 +50,10 @@ public:
 	//! Presolve update
 	virtual void PreSolveUpdate() override;
 
+private:
+	//! apply the update vectors to m_q
+	void ApplyUpdates(int n0, int nups);
+
 private:
 	// keep a pointer to the linear solver
 	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
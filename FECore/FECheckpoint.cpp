@@ -0,0 +1,121 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FECheckpoint.h"
+#include "FEModel.h"
+#include "FEMesh.h"
+#include "FEDomain.h"
+
+//-----------------------------------------------------------------------------
+FECheckpoint::FECheckpoint(FEModel& fem) : m_fem(fem), m_dmp(fem)
+{
+	m_dmp.SetCheckpoint(true);
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::Save()
+{
+	CopyNodes(true);
+	CopyMaterialPoints(true);
+
+	// serialize everything else
+	m_dmp.reset();
+	m_fem.Serialize(m_dmp);
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::Restore()
+{
+	CopyNodes(false);
+	CopyMaterialPoints(false);
+
+	m_dmp.Open(false, true);
+	m_fem.Serialize(m_dmp);
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::CopyNodes(bool bsave)
+{
+	FEMesh& mesh = m_fem.GetMesh();
+	int NN = mesh.Nodes();
+	if (bsave)
+	{
+		size_t n = 0;
+		for (int i = 0; i < NN; ++i) n += mesh.Node(i).StateSize();
+		m_node.resize(n);
+	}
+	if (m_node.empty()) return;
+
+	double* pd = &m_node[0];
+	for (int i = 0; i < NN; ++i) mesh.Node(i).CopyState(pd, bsave);
+	assert(pd == &m_node[0] + m_node.size());
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::CopyMaterialPoints(bool bsave)
+{
+	FEMesh& mesh = m_fem.GetMesh();
+	if (bsave)
+	{
+		size_t n = 0;
+		for (int nd = 0; nd < mesh.Domains(); ++nd)
+		{
+			FEDomain& dom = mesh.Domain(nd);
+			for (int i = 0; i < dom.Elements(); ++i)
+			{
+				FEElement& el = dom.ElementRef(i);
+				for (int j = 0; j < el.GaussPoints(); ++j)
+				{
+					int m = el.GetMaterialPoint(j)->CheckpointSize();
+					if (m > 0) n += m;
+				}
+			}
+		}
+		m_point.resize(n);
+	}
+	if (m_point.empty()) return;
+
+	double* pd = &m_point[0];
+	for (int nd = 0; nd < mesh.Domains(); ++nd)
+	{
+		FEDomain& dom = mesh.Domain(nd);
+		for (int i = 0; i < dom.Elements(); ++i)
+		{
+			FEElement& el = dom.ElementRef(i);
+			for (int j = 0; j < el.GaussPoints(); ++j)
+			{
+				FEMaterialPoint* mp = el.GetMaterialPoint(j);
+				if (mp->CheckpointSize() >= 0) mp->CopyCheckpoint(pd, bsave);
+			}
+		}
+	}
+	assert(pd == &m_point[0] + m_point.size());
+}
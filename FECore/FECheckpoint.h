@@ -0,0 +1,64 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "DumpMemStream.h"
+#include <vector>
+
+class FEModel;
+
+//-----------------------------------------------------------------------------
+//! This class stores the model state so that it can be restored when a time 
+//! step needs to be retried. The nodal data and the state of the material 
+//! points that support FEMaterialPoint::CopyState are copied to flat buffers.
+//! The buffers are reused, so after the first save this does not allocate. All
+//! other data (including material points that don't support CopyState) is 
+//! serialized to a memory stream.
+class FECORE_API FECheckpoint
+{
+public:
+	FECheckpoint(FEModel& fem);
+
+	//! save the current model state
+	void Save();
+
+	//! restore the model state from the last save
+	void Restore();
+
+private:
+	void CopyNodes(bool bsave);
+	void CopyMaterialPoints(bool bsave);
+
+private:
+	FEModel&			m_fem;
+	DumpMemStream		m_dmp;		//!< stream for the serialized data
+	std::vector<double>	m_node;		//!< nodal data
+	std::vector<double>	m_point;	//!< material point data
+};
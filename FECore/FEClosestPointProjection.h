@@ -28,13 +28,15 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FENNQuery.h"
+#include "FESurfaceBVH.h"
 #include "FEElemElemList.h"
 #include "FENodeElemList.h"
 
 //-----------------------------------------------------------------------------
 // This class can be used to find the closest point projection of a point
-// onto a surface.
+// onto a surface. The closest surface node is found with a bounding volume
+// hierarchy. After Init, the Project functions do not modify this object so 
+// they can be called from multiple threads.
 class FECORE_API FEClosestPointProjection
 {
 public:
@@ -44,6 +46,10 @@ public:
 	//! Initialization
 	bool Init();
 
+	//! Update the search structures to the current nodal positions. This is 
+	//! cheaper than calling Init again.
+	void Update();
+
 	//! Project a point onto surface
 	FESurfaceElement* Project(const vec3d& x, vec3d& q, vec2d& r);
 
@@ -81,7 +87,7 @@ protected:
 
 protected:
 	FESurface&		m_surf;		//!< reference to surface
-	FENNQuery		m_SNQ;		//!< used to find the nearest neighbour
+	FESurfaceBVH	m_bvh;		//!< used to find the nearest neighbour
 	FENodeElemList	m_NEL;		//!< node-element tree
 	FEElemElemList	m_EEL;		//!< element neighbor list
 };
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "DumpStream.h"
 #include "FEMesh.h"
 #include "FEGlobalMatrix.h"
+#include "FENodeElemList.h"
 
 //-----------------------------------------------------------------------------
 FEDomain::FEDomain(int nclass, FEModel* fem) : FEMeshPartition(nclass, fem)
@@ -36,6 +37,15 @@ FEDomain::FEDomain(int nclass, FEModel* fem) : FEMeshPartition(nclass, fem)
 
 }
 
+//-----------------------------------------------------------------------------
+bool FEDomain::Init()
+{
+	// the element connectivity may have changed, so we need a new coloring
+	m_elemColor.clear();
+
+	return FEMeshPartition::Init();
+}
+
 //-----------------------------------------------------------------------------
 void FEDomain::SetMaterial(FEMaterial* pm)
 {
@@ -87,7 +97,12 @@ void FEDomain::Serialize(DumpStream& ar)
 			FEElement& el = ElementRef(i);
 			el.Serialize(ar);
 			int nint = el.GaussPoints();
-			for (int j = 0; j < nint; ++j) el.GetMaterialPoint(j)->Serialize(ar);
+			for (int j = 0; j < nint; ++j)
+			{
+				// for checkpoints, points that support it are copied separately
+				FEMaterialPoint* mp = el.GetMaterialPoint(j);
+				if ((ar.IsCheckpoint() == false) || (mp->CheckpointSize() < 0)) mp->Serialize(ar);
+			}
 		}
 	}
 	else
@@ -196,3 +211,49 @@ void FEDomain::Activate(const FEDofList& dof)
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+// Build a greedy element coloring such that no two elements of the same color 
+// share a node. Each element gets the lowest color that is not used by any of
+// its neighbors (i.e. elements that share a node with it). 
+void FEDomain::CreateElementColoring()
+{
+	m_elemColor.clear();
+	const int NE = Elements();
+	if (NE == 0) return;
+
+	FENodeElemList NEL;
+	NEL.Create(*this);
+
+	vector<int> color(NE, -1);
+
+	// tag[c] == i means color c is used by a neighbor of element i
+	vector<int> tag;
+	int ncolors = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int neln = el.Nodes();
+		for (int j = 0; j < neln; ++j)
+		{
+			int n = el.m_node[j];
+			int nval = NEL.Valence(n);
+			int* eli = NEL.ElementIndexList(n);
+			for (int k = 0; k < nval; ++k)
+			{
+				int ck = color[eli[k]];
+				if (ck >= 0) tag[ck] = i;
+			}
+		}
+
+		// find the first available color
+		int c = 0;
+		while ((c < ncolors) && (tag[c] == i)) ++c;
+		if (c == ncolors) { ncolors++; tag.push_back(-1); }
+		color[i] = c;
+	}
+
+	// group the elements by color
+	m_elemColor.resize(ncolors);
+	for (int i = 0; i < NE; ++i) m_elemColor[color[i]].push_back(i);
+}
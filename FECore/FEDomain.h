@@ -38,6 +38,9 @@ class FECORE_API FEDomain : public FEMeshPartition
 public:
 	FEDomain(int nclass, FEModel* fem);
 
+	//! initialize domain
+	bool Init() override;
+
 	//! get the material of this domain
 	virtual FEMaterial* GetMaterial() { return 0; }
 
@@ -51,7 +54,7 @@ public:
 	//! This is called after elements get read in from the input file.
 	//! And must be called before material point data can be accessed.
 	//! \todo Perhaps I can make this part of the "creation" routine
-	void CreateMaterialPointData();
+	virtual void CreateMaterialPointData();
 
 	// serialization
 	void Serialize(DumpStream& ar) override;
@@ -77,10 +80,25 @@ public:
 	//! Activate the domain
 	virtual void Activate();
 
+public:
+	//! Build a greedy element coloring such that elements of the same color
+	//! share no nodes. Elements of the same color can therefore be assembled
+	//! concurrently without atomic updates.
+	void CreateElementColoring();
+
+	//! return the number of element colors (zero if no coloring was created)
+	int ElementColors() const { return (int)m_elemColor.size(); }
+
+	//! return the list of element indices of a color
+	const vector<int>& ElementColor(int i) const { return m_elemColor[i]; }
+
 protected:
 	// helper function for activating dof lists
 	void Activate(const FEDofList& dof);
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+private:
+	vector< vector<int> >	m_elemColor;	//!< element indices, grouped by color
 };
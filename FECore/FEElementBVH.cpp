@@ -0,0 +1,100 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEElementBVH.h"
+#include "FEMeshPartition.h"
+#include "FEMesh.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+FEElementBVH::FEElementBVH(FEMeshPartition* dom) : m_dom(dom)
+{
+}
+
+//-----------------------------------------------------------------------------
+int FEElementBVH::Items() const
+{
+	return (m_dom ? m_dom->Elements() : 0);
+}
+
+//-----------------------------------------------------------------------------
+// calculate the bounding box of an element
+void FEElementBVH::ItemBox(int i, vec3d& r0, vec3d& r1) const
+{
+	FEMesh& mesh = *m_dom->GetMesh();
+	const FEElement& el = m_dom->ElementRef(i);
+	int ne = el.Nodes();
+	r0 = r1 = mesh.Node(el.m_node[0]).m_rt;
+	for (int j = 1; j < ne; ++j)
+	{
+		const vec3d& r = mesh.Node(el.m_node[j]).m_rt;
+		if (r.x < r0.x) r0.x = r.x; if (r.x > r1.x) r1.x = r.x;
+		if (r.y < r0.y) r0.y = r.y; if (r.y > r1.y) r1.y = r.y;
+		if (r.z < r0.z) r0.z = r.z; if (r.z > r1.z) r1.z = r.z;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEElementBVH::FindCandidates(const vec3d& x, vector<int>& elemList) const
+{
+	elemList.clear();
+	if (m_node.empty()) return;
+
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+		if ((x.x < node.r0.x) || (x.y < node.r0.y) || (x.z < node.r0.z) ||
+			(x.x > node.r1.x) || (x.y > node.r1.y) || (x.z > node.r1.z)) continue;
+
+		if (node.child >= 0)
+		{
+			stack[ns++] = node.child + 1;
+			stack[ns++] = node.child;
+		}
+		else
+		{
+			// leaf boxes are tight, but we still need to check the individual elements
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				vec3d r0, r1;
+				ItemBox(m_item[i], r0, r1);
+				if ((x.x >= r0.x) && (x.y >= r0.y) && (x.z >= r0.z) &&
+					(x.x <= r1.x) && (x.y <= r1.y) && (x.z <= r1.z)) elemList.push_back(m_item[i]);
+			}
+		}
+	}
+
+	sort(elemList.begin(), elemList.end());
+}
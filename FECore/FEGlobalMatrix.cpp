@@ -35,12 +35,14 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el)
 {
+	m_elem = &el;
 	m_node = el.m_node;
 }
 
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 {
+	m_elem = ke.m_elem;
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
@@ -49,6 +51,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 {
+	m_elem = ke.m_elem;
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
@@ -60,6 +63,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) : matrix((int)lmi.size(), (int)lmi.size())
 {
+	m_elem = &el;
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmi;
@@ -68,6 +72,7 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) :
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el, vector<int>& lmi, vector<int>& lmj) : matrix((int)lmi.size(), (int)lmj.size())
 {
+	m_elem = &el;
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmj;
@@ -80,6 +85,23 @@ void FEElementMatrix::operator = (const matrix& ke)
 	matrix::operator=(ke);
 }
 
+//-----------------------------------------------------------------------------
+void FEElementMatrix::SetElement(const FEElement& el)
+{
+	m_elem = &el;
+	m_node.assign(el.m_node.begin(), el.m_node.end());
+}
+
+//-----------------------------------------------------------------------------
+void FEElementMatrix::SetElement(const FEElement& el, const vector<int>& lmi)
+{
+	SetElement(el);
+	m_lmi.assign(lmi.begin(), lmi.end());
+	m_lmj.assign(lmi.begin(), lmi.end());
+	int n = (int)lmi.size();
+	resize(n, n);
+}
+
 
 //-----------------------------------------------------------------------------
 //! Takes a SparseMatrix structure that defines the structure of the global matrix.
@@ -90,6 +112,7 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK, bool del)
 	m_pMP = 0;
 	m_nlm = 0;
 	m_delA = del;
+	m_buseAsmMap = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -144,17 +167,16 @@ void FEGlobalMatrix::build_add(vector<int>& lm)
 //! flushin operation causes the actual update of the matrix profile.
 void FEGlobalMatrix::build_flush()
 {
-	int i, j, n, *lm;
-
 	// Since prescribed dofs have an equation number of < -1 we need to modify that
 	// otherwise no storage will be allocated for these dofs (even not diagonal elements!).
-	for (i=0; i<m_nlm; ++i)
+#pragma omp parallel for
+	for (int i=0; i<m_nlm; ++i)
 	{
-		n = (int)m_LM[i].size();
+		int n = (int)m_LM[i].size();
 		if (n > 0)
 		{
-			lm = &(m_LM[i])[0];
-			for (j=0; j<n; ++j) if (lm[j] < -1) lm[j] = -lm[j]-2;
+			int* lm = &(m_LM[i])[0];
+			for (int j=0; j<n; ++j) if (lm[j] < -1) lm[j] = -lm[j]-2;
 		}
 	}
 
@@ -168,11 +190,28 @@ void FEGlobalMatrix::build_flush()
 void FEGlobalMatrix::build_end()
 {
 	if (m_nlm > 0) build_flush();
+
+	// the matrix structure will change, so any cached assembly maps are invalid
+	m_asmDomain.clear();
+	m_asmMap.clear();
+
 	m_pA->Create(*m_pMP);
 }
 
 //-----------------------------------------------------------------------------
 bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
+{
+	// build the profile
+	BuildProfile(pfem, neq, breset);
+
+	// All done! We can now create the actual sparse matrix.
+	CreateFromProfile(pfem);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEGlobalMatrix::BuildProfile(FEModel* pfem, int neq, bool breset)
 {
 	// The first time we come here we build the "static" profile.
 	// This static profile stores the contribution to the matrix profile
@@ -182,6 +221,10 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	// reconstructing it every time we come here saves us a lot of time. The 
 	// static profile is stored in the variable m_MPs.
 
+	// hold on to the current profile, so we can see if anything changed
+	SparseMatrixProfile* oldMP = m_pMP;
+	m_pMP = nullptr;
+
 	// begin building the profile
 	build_begin(neq);
 	{
@@ -213,11 +256,28 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		// Add the "dynamic" profile
 		pfem->BuildMatrixProfile(*this, false);
 	}
-	// All done! We can now finish building the profile and create 
-	// the actual sparse matrix. This is done in the following function
+	if (m_nlm > 0) build_flush();
+
+	// The old profile only describes the sparse matrix if the matrix was created 
+	// from it and wasn't cleared since.
+	bool bchanged = true;
+	if (oldMP && (m_pA->NonZeroes() > 0) && (m_pA->Rows() == neq))
+	{
+		bchanged = ((*oldMP == *m_pMP) == false);
+	}
+	delete oldMP;
+
+	return bchanged;
+}
+
+//-----------------------------------------------------------------------------
+void FEGlobalMatrix::CreateFromProfile(FEModel* pfem)
+{
+	// create the sparse matrix
 	build_end();
 
-	return true;
+	// allocate the assembly maps
+	if (m_buseAsmMap) InitAssemblyMaps(pfem->GetMesh());
 }
 
 //-----------------------------------------------------------------------------
@@ -316,5 +376,74 @@ bool FEGlobalMatrix::Create(const FESurface& surf, const std::vector<int>& equat
 
 void FEGlobalMatrix::Assemble(const FEElementMatrix& ke)
 {
-	m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
+	// see if we have an assembly map for this element
+	ElementAssemblyMap* pm = FindAssemblyMap(ke);
+	if (pm)
+	{
+		const vector<int>& lmi = ke.RowIndices();
+		const vector<int>& lmj = ke.ColumnsIndices();
+		int nr = ke.rows();
+		int nc = ke.columns();
+
+		// (re)build the map when the element is assembled for the first time
+		// or with different equation numbers.
+		// NOTE: Each element is assembled by only one thread at a time, so this is safe.
+		if ((pm->nr != nr) || (pm->nc != nc) || (pm->lmi != lmi) || (pm->lmj != lmj))
+		{
+			m_pA->AssemblyMap(nr, nc, lmi, lmj, pm->map);
+			pm->nr = nr;
+			pm->nc = nc;
+			pm->lmi = lmi;
+			pm->lmj = lmj;
+		}
+
+		m_pA->AssembleMapped(ke, pm->map);
+	}
+	else m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
+}
+
+//-----------------------------------------------------------------------------
+//! Allocate the assembly maps for all domain elements. The maps themselves are
+//! calculated when the elements are assembled.
+void FEGlobalMatrix::InitAssemblyMaps(FEMesh& mesh)
+{
+	m_asmDomain.clear();
+	m_asmMap.clear();
+
+	// make sure the sparse matrix supports assembly maps
+	vector<int> lm, map;
+	if (m_pA->AssemblyMap(0, 0, lm, lm, map) == false) return;
+
+	const int ND = mesh.Domains();
+	m_asmDomain.resize(ND);
+	m_asmMap.resize(ND);
+	for (int i = 0; i < ND; ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		m_asmDomain[i] = &dom;
+
+		ElementAssemblyMap empty;
+		empty.nr = empty.nc = 0;
+		m_asmMap[i].assign(dom.Elements(), empty);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! find the cached assembly map of an element matrix
+FEGlobalMatrix::ElementAssemblyMap* FEGlobalMatrix::FindAssemblyMap(const FEElementMatrix& ke)
+{
+	const FEElement* pe = ke.Element();
+	if ((pe == nullptr) || m_asmMap.empty()) return nullptr;
+
+	const FEMeshPartition* dom = pe->GetMeshPartition();
+	for (size_t i = 0; i < m_asmDomain.size(); ++i)
+	{
+		if (m_asmDomain[i] == dom)
+		{
+			int lid = pe->GetLocalID();
+			if ((lid >= 0) && (lid < (int)m_asmMap[i].size())) return &m_asmMap[i][lid];
+			return nullptr;
+		}
+	}
+	return nullptr;
 }
@@ -37,6 +37,7 @@ class FEModel;
 class FEMesh;
 class FESurface;
 class FEElement;
+class FEMeshPartition;
 
 //-----------------------------------------------------------------------------
 //! This class represents an element matrix, i.e. a matrix of values and the row and
@@ -45,8 +46,8 @@ class FECORE_API FEElementMatrix : public matrix
 {
 public:
 	// default constructor
-	FEElementMatrix(){}
-	FEElementMatrix(int nr, int nc) : matrix(nr, nc) {}
+	FEElementMatrix() : m_elem(nullptr) {}
+	FEElementMatrix(int nr, int nc) : matrix(nr, nc), m_elem(nullptr) {}
 	FEElementMatrix(const FEElement& el);
 
 	// constructor for symmetric matrices
@@ -62,6 +63,14 @@ public:
 	// assignment operator
 	void operator = (const matrix& ke);
 
+	// Prepare the matrix for a new element. The allocated storage is reused, so a single 
+	// (e.g. thread-local) element matrix can be used for all the elements of a domain 
+	// without allocating memory for each element.
+	void SetElement(const FEElement& el);
+
+	// same as above, but also sets the indices and resizes the matrix (values are not zeroed)
+	void SetElement(const FEElement& el, const vector<int>& lmi);
+
 	// row indices
 	std::vector<int>& RowIndices() { return m_lmi; }
 	const std::vector<int>& RowIndices() const { return m_lmi; }
@@ -82,7 +91,11 @@ public:
 	// get the nodes
 	const std::vector<int>& Nodes() const { return m_node; }
 
+	// get the element this matrix was created for (can be null)
+	const FEElement* Element() const { return m_elem; }
+
 private:
+	const FEElement*	m_elem;	//!< element (can be null)
 	std::vector<int>	m_node;	//!< node indices
 	std::vector<int>	m_lmi;	//!< row indices
 	std::vector<int>	m_lmj;	//!< column indices
@@ -116,6 +129,15 @@ public:
 	//! construct the stiffness matrix from a FEM object
 	bool Create(FEModel* pfem, int neq, bool breset);
 
+	//! Build the matrix profile of a FEM object, without creating the sparse matrix.
+	//! Returns false if the new profile is identical to the profile of the current
+	//! sparse matrix, in which case the matrix (and the symbolic factorization of the 
+	//! linear solver) can be reused. Otherwise, call CreateFromProfile next.
+	bool BuildProfile(FEModel* pfem, int neq, bool breset);
+
+	//! create the sparse matrix from the profile that was built with BuildProfile
+	void CreateFromProfile(FEModel* pfem);
+
 	//! construct the stiffness matrix from a mesh
 	bool Create(FEMesh& mesh, int neq);
 
@@ -153,12 +175,33 @@ public:
 	//! get the sparse matrix profile
 	SparseMatrixProfile* GetSparseMatrixProfile() { return m_pMP; }
 
+	//! Turn the caching of element assembly maps on or off. When on, the offsets 
+	//! of each domain element's entries in the sparse matrix are computed the first
+	//! time the element is assembled and reused until the matrix profile changes.
+	void SetUseAssemblyMap(bool b) { m_buseAsmMap = b; }
+
 public:
 	void build_begin(int neq);
 	void build_add(std::vector<int>& lm);
 	void build_end();
 	void build_flush();
 
+protected:
+	//! the cached assembly map of an element
+	struct ElementAssemblyMap
+	{
+		int		nr, nc;				//!< size of element matrix
+		std::vector<int>	lmi;	//!< row equation numbers the map was built for
+		std::vector<int>	lmj;	//!< column equation numbers the map was built for
+		std::vector<int>	map;	//!< offsets into the sparse matrix' value array
+	};
+
+	//! find the cached assembly map of an element matrix (returns null if there is none)
+	ElementAssemblyMap* FindAssemblyMap(const FEElementMatrix& ke);
+
+	//! allocate the (empty) assembly maps for all domain elements
+	void InitAssemblyMaps(FEMesh& mesh);
+
 protected:
 	SparseMatrix*	m_pA;	//!< the actual global stiffness matrix
 	bool			m_delA;	//!< delete A in destructor
@@ -170,4 +213,9 @@ protected:
 	SparseMatrixProfile		m_MPs;		//!< the "static" part of the matrix profile
 	vector< vector<int> >	m_LM;		//!< used for building the stiffness matrix
 	int	m_nlm;				//!< nr of elements in m_LM array
+
+	// cached assembly maps
+	bool	m_buseAsmMap;
+	vector<const FEMeshPartition*>			m_asmDomain;	//!< domains with assembly maps
+	vector< vector<ElementAssemblyMap> >	m_asmMap;		//!< assembly maps for each domain element
 };
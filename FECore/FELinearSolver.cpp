@@ -42,6 +42,7 @@ SOFTWARE.*/
 #include "FEBodyLoad.h"
 #include "DumpStream.h"
 #include "FELinearConstraintManager.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -145,6 +146,7 @@ bool FELinearSolver::Init()
 		feLogError("Failed allocating stiffness matrix\n\n");
 		return false;
 	}
+	m_pK->SetUseAssemblyMap(m_bassemblyMap);
 
 	// Set the matrix formation flag
 	m_breform = true;
@@ -193,6 +195,7 @@ bool FELinearSolver::SolveStep()
 	FEGlobalVector rhs(fem, m_R, F);
 	{
 		TRACK_TIME(TimerID::Timer_Residual);
+		FE_PROFILE("residual");
 		ForceVector(rhs);
 	}
 
@@ -206,6 +209,7 @@ bool FELinearSolver::SolveStep()
 	vector<double> u(m_neq);
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE("backsolve");
 		if (m_pls->BackSolve(u, m_R) == false)
 			throw LinearSolverFailed();
 	}
@@ -235,6 +239,7 @@ bool FELinearSolver::ReformStiffness()
 	if (m_breform)
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
+		FE_PROFILE("reform");
 
 		if (!CreateStiffness()) return false;
 		
@@ -250,6 +255,7 @@ bool FELinearSolver::ReformStiffness()
 	// (This is done by the derived class)
 	{
 		TRACK_TIME(TimerID::Timer_Stiffness);
+		FE_PROFILE("stiffness");
 
 		FELinearSystem K(this, *m_pK, m_R, m_u, (m_msymm == REAL_SYMMETRIC));
 		if (!StiffnessMatrix(K)) return false;
@@ -262,12 +268,14 @@ bool FELinearSolver::ReformStiffness()
 	// factorize the stiffness matrix
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE("factor");
 		m_pls->Factor();
 	}
 
 	// increase total nr of reformations
 	m_nref++;
 	m_ntotref++;
+	FEProfiler::GetInstance()->AddCount("reformations");
 
 	return true;
 }
@@ -295,11 +303,16 @@ bool FELinearSolver::CreateStiffness()
 		int nnz = m_pK->NonZeroes();
 		feLog("\tNr of equations ........................... : %d\n", neq);
 		feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
+
+		FEProfiler* prof = FEProfiler::GetInstance();
+		prof->AddCount("matrix allocations");
+		prof->SetValue("matrix nonzeroes", nnz);
 	}
 
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE("reorder");
 		if (!m_pls->PreProcess()) throw FatalError();
 	}
 
@@ -57,6 +57,26 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// See if domains can assemble their elements color by color without atomic updates.
+bool FELinearSystem::ColoredAssembly() const
+{
+	if ((m_solver == nullptr) || (m_solver->m_bcoloredAssembly == false)) return false;
+
+	// linear constraints can couple equations of elements of the same color
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	return (LCM.LinearConstraints() == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Turn the atomic updates of the global matrix and the RHS on or off.
+void FELinearSystem::SetAtomicAssembly(bool b)
+{
+	SparseMatrix& K = m_K;
+	K.SetAtomicAssembly(b);
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
@@ -88,8 +108,12 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				if (I >= 0)
 				{
 					// dof i is not a prescribed degree of freedom
+					if (K.AtomicAssembly())
+					{
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+						m_F[I] -= ke[i][j] * m_u[J];
+					}
+					else m_F[I] -= ke[i][j] * m_u[J];
 				}
 			}
 
@@ -98,16 +122,15 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 	}
 
-#pragma omp critical
-	{
+	// only enter the critical section when there are linear constraints
 	FEModel* fem = m_solver->GetFEModel();
 	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
 	if (LCM.LinearConstraints())
 	{
 		const vector<int>& en = ke.Nodes();
+#pragma omp critical
 		LCM.AssembleStiffness(m_K, m_F, m_u, en, lmi, lmj, ke);
 	}
-	} // omp critical
 }
 
 //-----------------------------------------------------------------------------
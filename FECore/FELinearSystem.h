@@ -56,6 +56,15 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+	// See if domains can assemble their elements color by color without atomic updates.
+	// This requires the solver's colored_assembly flag and no linear constraints.
+	bool ColoredAssembly() const;
+
+	// Turn the atomic updates of the global matrix and the RHS on or off.
+	// Only turn this off when the caller guarantees that concurrent calls to
+	// Assemble never touch the same equations (e.g. elements of the same color).
+	void SetAtomicAssembly(bool b);
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -30,24 +30,132 @@ SOFTWARE.*/
 #include "FEMaterialPoint.h"
 #include "DumpStream.h"
 #include <string.h>
+#include <map>
+#include <typeinfo>
+#include <atomic>
+
+std::atomic<int> FEMaterialPoint::m_layoutGeneration(0);
+
+//-----------------------------------------------------------------------------
+// size of the memory pool blocks
+#define POOL_BLOCK_SIZE	(1 << 20)
+
+// Each allocation is preceded by a header that stores the pool it was allocated
+// from (or null if it was allocated from the heap). 16 bytes keeps the data aligned.
+#define POOL_HEADER_SIZE	16
+
+static thread_local FEMaterialPointPool* activePool = 0;
+
+FEMaterialPointPool::FEMaterialPointPool()
+{
+	m_used = m_size = 0;
+}
+
+FEMaterialPointPool::~FEMaterialPointPool()
+{
+	Clear();
+}
+
+void FEMaterialPointPool::Clear()
+{
+	for (size_t i = 0; i < m_block.size(); ++i) delete [] m_block[i];
+	m_block.clear();
+	m_used = m_size = 0;
+}
+
+void* FEMaterialPointPool::Allocate(size_t size)
+{
+	// round up to keep the data aligned
+	size = (size + 15) & ~((size_t)15);
+
+	if (m_block.empty() || (m_used + size > m_size))
+	{
+		m_size = (size > POOL_BLOCK_SIZE ? size : POOL_BLOCK_SIZE);
+		m_block.push_back(new char[m_size]);
+		m_used = 0;
+	}
+
+	void* p = m_block.back() + m_used;
+	m_used += size;
+	return p;
+}
+
+void FEMaterialPointPool::SetActive(FEMaterialPointPool* pool)
+{
+	activePool = pool;
+}
+
+FEMaterialPointPool* FEMaterialPointPool::Active()
+{
+	return activePool;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPoint::operator new(size_t size)
+{
+	FEMaterialPointPool* pool = FEMaterialPointPool::Active();
+	char* p = (char*)(pool ? pool->Allocate(size + POOL_HEADER_SIZE) : ::operator new(size + POOL_HEADER_SIZE));
+	*((FEMaterialPointPool**)p) = pool;
+	return p + POOL_HEADER_SIZE;
+}
+
+void FEMaterialPoint::operator delete(void* p)
+{
+	if (p == 0) return;
+
+	// memory that was allocated from a pool is released by the pool
+	char* c = (char*)p - POOL_HEADER_SIZE;
+	if (*((FEMaterialPointPool**)c) == 0) ::operator delete(c);
+}
+
+//-----------------------------------------------------------------------------
 
 FEMaterialPoint::FEMaterialPoint(FEMaterialPoint* ppt)
 {
 	m_pPrev = 0;
 	m_pNext = ppt;
 	m_elem = 0;
-	if (ppt) ppt->m_pPrev = this;
+	m_cache = 0;
+	if (ppt)
+	{
+		ppt->m_pPrev = this;
+		ListChanged(ppt);
+	}
+}
+
+// The copy does not take over the cached layout, since it may be placed in a different list.
+FEMaterialPoint::FEMaterialPoint(const FEMaterialPoint& mp)
+{
+	m_r0 = mp.m_r0;
+	m_rt = mp.m_rt;
+	m_J0 = mp.m_J0;
+	m_Jt = mp.m_Jt;
+	m_elem = mp.m_elem;
+	m_index = mp.m_index;
+	m_shape = mp.m_shape;
+	m_pNext = mp.m_pNext;
+	m_pPrev = mp.m_pPrev;
+	m_cache = 0;
 }
 
 FEMaterialPoint::~FEMaterialPoint()
 { 
 	if (m_pNext) delete m_pNext;
 	m_pNext = m_pPrev = 0;
+
+	Cache* c = m_cache.load();
+	while (c)
+	{
+		Cache* prev = c->m_prev;
+		delete c;
+		c = prev;
+	}
 }
 
 void FEMaterialPoint::SetPrev(FEMaterialPoint* pt)
 {
 	m_pPrev = pt;
+	ListChanged(this);
 }
 
 // TODO: What if the next pointer is already assigned?
@@ -55,6 +163,150 @@ void FEMaterialPoint::SetNext(FEMaterialPoint* pt)
 {
 	m_pNext = pt;
 	pt->m_pPrev = this;
+	ListChanged(this);
+}
+
+//-----------------------------------------------------------------------------
+// type tests of the data slots
+static bool (*dataSlotType[256])(const FEMaterialPoint*) = { 0 };
+static int dataSlots = 0;
+
+int FEMaterialPoint::NewDataSlot(bool (*isType)(const FEMaterialPoint*))
+{
+	int slot = 0;
+	#pragma omp critical (FEMaterialPoint_layout)
+	{
+		slot = dataSlots++;
+		if (slot < MAX_DATA_SLOTS) dataSlotType[slot] = isType;
+	}
+	return slot;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPoint::ListChanged(FEMaterialPoint* pt)
+{
+	while (pt->m_pPrev) pt = pt->m_pPrev;
+	if (pt->HasCachedLayout()) ++m_layoutGeneration;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMaterialPoint::HasCachedLayout()
+{
+	for (FEMaterialPoint* pt = this; pt; pt = pt->m_pNext)
+	{
+		if (pt->m_cache.load()) return true;
+		for (int i = 0; i < pt->Components(); ++i)
+		{
+			FEMaterialPoint* pi = pt->GetPointData(i);
+			if (pi && (pi != pt) && pi->HasCachedLayout()) return true;
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+int FEMaterialPoint::SearchData(bool (*isType)(const FEMaterialPoint*))
+{
+	// first see if this is the correct type
+	if (isType(this)) return 0;
+
+	// check all the child classes 
+	int k = 1;
+	for (FEMaterialPoint* pt = m_pNext; pt; pt = pt->m_pNext, ++k)
+		if (isType(pt)) return k;
+
+	// search up
+	k = -1;
+	for (FEMaterialPoint* pt = m_pPrev; pt; pt = pt->m_pPrev, --k)
+		if (isType(pt)) return k;
+
+	return DATA_NOT_FOUND;
+}
+
+//-----------------------------------------------------------------------------
+// The layout is defined by the types of the points down and up the list. Each thread
+// keeps its own map of the layouts it has used, so the shared map is only locked 
+// when a thread encounters a layout for the first time.
+FEMaterialPoint::Layout* FEMaterialPoint::FindLayout()
+{
+	typedef vector<const std::type_info*> LayoutKey;
+
+	static thread_local LayoutKey key;
+	key.clear();
+	for (FEMaterialPoint* pt = this; pt; pt = pt->m_pNext) key.push_back(&typeid(*pt));
+	key.push_back(0);
+	for (FEMaterialPoint* pt = m_pPrev; pt; pt = pt->m_pPrev) key.push_back(&typeid(*pt));
+
+	static thread_local std::map<LayoutKey, Layout*> threadLayouts;
+	std::map<LayoutKey, Layout*>::iterator it = threadLayouts.find(key);
+	if (it != threadLayouts.end()) return it->second;
+
+	static std::map<LayoutKey, Layout> layouts;
+	Layout* layout = 0;
+	#pragma omp critical (FEMaterialPoint_layout)
+	{
+		std::map<LayoutKey, Layout>::iterator il = layouts.find(key);
+		if (il == layouts.end())
+		{
+			// fill in the positions of the data types that have a slot
+			layout = &layouts[key];
+			for (int i = 0; i < MAX_DATA_SLOTS; ++i)
+			{
+				int n = (i < dataSlots ? SearchData(dataSlotType[i]) : DATA_NOT_SEARCHED);
+				layout->m_offset[i].store(n, std::memory_order_relaxed);
+			}
+		}
+		else layout = &il->second;
+	}
+	threadLayouts[key] = layout;
+
+	return layout;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPoint* FEMaterialPoint::FindData(int slot, bool (*isType)(const FEMaterialPoint*))
+{
+	if (slot >= MAX_DATA_SLOTS)
+	{
+		int n = SearchData(isType);
+		if (n == DATA_NOT_FOUND) return 0;
+
+		FEMaterialPoint* pt = this;
+		for (; n > 0; --n) pt = pt->m_pNext;
+		for (; n < 0; ++n) pt = pt->m_pPrev;
+		return pt;
+	}
+
+	// find the layout of this point and cache it, together with the points of the list
+	int gen = m_layoutGeneration.load();
+	Cache* c = m_cache.load(std::memory_order_acquire);
+	while ((c == 0) || (c->m_gen != gen))
+	{
+		Cache* cn = new Cache;
+		cn->m_layout = FindLayout();
+		cn->m_gen = gen;
+		cn->m_up = 0;
+		FEMaterialPoint* top = this;
+		while (top->m_pPrev) { top = top->m_pPrev; cn->m_up++; }
+		for (FEMaterialPoint* pt = top; pt; pt = pt->m_pNext) cn->m_item.push_back(pt);
+		cn->m_prev = c;
+
+		// if another thread published a cache in the meantime, we use that one
+		if (m_cache.compare_exchange_strong(c, cn, std::memory_order_acq_rel, std::memory_order_acquire)) c = cn;
+		else delete cn;
+	}
+
+	// Points with the same layout find the data at the same position. Types that were
+	// given a slot after the layout was created are searched here (once per layout).
+	int n = c->m_layout->m_offset[slot].load(std::memory_order_relaxed);
+	if (n == DATA_NOT_SEARCHED)
+	{
+		n = SearchData(isType);
+		#pragma omp critical (FEMaterialPoint_layout)
+		c->m_layout->m_offset[slot].store(n, std::memory_order_relaxed);
+	}
+
+	return (n == DATA_NOT_FOUND ? 0 : c->m_item[c->m_up + n]);
 }
 
 void FEMaterialPoint::Init()
@@ -76,6 +328,25 @@ void FEMaterialPoint::Serialize(DumpStream& ar)
 	if (m_pNext) m_pNext->Serialize(ar);
 }
 
+//-----------------------------------------------------------------------------
+int FEMaterialPoint::CheckpointSize()
+{
+	int n = 0;
+	for (FEMaterialPoint* pt = this; pt; pt = pt->m_pNext)
+	{
+		int m = pt->StateSize();
+		if (m < 0) return -1;
+		n += m;
+	}
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPoint::CopyCheckpoint(double*& pd, bool bsave)
+{
+	for (FEMaterialPoint* pt = this; pt; pt = pt->m_pNext) pt->CopyState(pd, bsave);
+}
+
 //-----------------------------------------------------------------------------
 FEMaterialPointArray::FEMaterialPointArray(FEMaterialPoint* ppt) : FEMaterialPoint(ppt)
 {
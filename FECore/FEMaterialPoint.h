@@ -31,10 +31,48 @@ SOFTWARE.*/
 #include "mat3d.h"
 #include "FETimeInfo.h"
 #include <vector>
+#include <type_traits>
+#include <atomic>
+#include <string.h>
 using namespace std;
 
 class FEElement;
 
+//-----------------------------------------------------------------------------
+//! Memory pool for material point data. While a pool is active (on the calling
+//! thread), all material point data is allocated from the pool so that the
+//! data of consecutive integration points is stored contiguously in memory. 
+//! Deleting material point data that was allocated from a pool does not 
+//! release any memory. The memory is released when the pool is destroyed, so
+//! the pool must outlive the material point data that was allocated from it.
+class FECORE_API FEMaterialPointPool
+{
+public:
+	FEMaterialPointPool();
+	~FEMaterialPointPool();
+
+	//! allocate a block of memory
+	void* Allocate(size_t size);
+
+	//! release all memory (all data allocated from the pool must have been deleted)
+	void Clear();
+
+	//! make this the active pool (or pass null to deactivate pooling)
+	static void SetActive(FEMaterialPointPool* pool);
+
+	//! get the active pool
+	static FEMaterialPointPool* Active();
+
+private:
+	FEMaterialPointPool(const FEMaterialPointPool&);
+	void operator = (const FEMaterialPointPool&);
+
+private:
+	vector<char*>	m_block;	//!< allocated memory blocks
+	size_t			m_used;		//!< bytes used in last block
+	size_t			m_size;		//!< size of last block
+};
+
 //-----------------------------------------------------------------------------
 //! Material point class
 
@@ -48,8 +86,13 @@ class FECORE_API FEMaterialPoint
 {
 public:
 	FEMaterialPoint(FEMaterialPoint* ppt = 0);
+	FEMaterialPoint(const FEMaterialPoint& mp);
 	virtual ~FEMaterialPoint();
 
+	// material point data is allocated from the active memory pool, if any
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+
 public:
 	//! The init function is used to intialize data
 	virtual void Init();
@@ -88,6 +131,31 @@ public:
 	// serialization
 	virtual void Serialize(DumpStream& ar);
 
+	//! Number of values (doubles) that CopyState copies, or -1 if this point does not support
+	//! CopyState. Points that support it must copy the same data as a shallow Serialize, but
+	//! excluding the data of the points down the list. 
+	virtual int StateSize() const { return -1; }
+
+	//! Copy the state of this point to (bsave = true) or from (bsave = false) a buffer. 
+	//! The buffer pointer is advanced by StateSize(). 
+	virtual void CopyState(double*& pd, bool bsave) {}
+
+	//! Number of values needed to store the state of this point and the points down the list,
+	//! or -1 if any of these points does not support CopyState.
+	int CheckpointSize();
+
+	//! Copy the state of this point and the points down the list (see CopyState).
+	void CopyCheckpoint(double*& pd, bool bsave);
+
+protected:
+	//! helper function for CopyState
+	template <class T> static void CopyValue(T& v, double*& pd, bool bsave)
+	{
+		static_assert(sizeof(T) % sizeof(double) == 0, "CopyValue: T must consist of doubles");
+		if (bsave) memcpy(pd, &v, sizeof(T)); else memcpy(&v, pd, sizeof(T));
+		pd += sizeof(T) / sizeof(double);
+	}
+
 public:
 	vec3d		m_r0;		//!< material point position
 	vec3d		m_rt;		//!< current point position
@@ -102,67 +170,98 @@ public:
 protected:
 	FEMaterialPoint*	m_pNext;	//<! next data in the list
 	FEMaterialPoint*	m_pPrev;	//<! previous data in the list
+
+private:
+	// Each type that is extracted with ExtractData is assigned a slot. The layout
+	// of a material point (i.e. the types of the data in the list, as seen from
+	// this point) stores for each slot where the data is located, relative to 
+	// this point. Points with the same layout share the same Layout object.
+	enum {
+		MAX_DATA_SLOTS    = 256,
+		DATA_NOT_SEARCHED = 0x7FFFFFFF,
+		DATA_NOT_FOUND    = 0x7FFFFFFE
+	};
+
+	struct Layout
+	{
+		std::atomic<int>	m_offset[MAX_DATA_SLOTS];
+	};
+
+	// returns a new data slot for the type identified by isType
+	static int NewDataSlot(bool (*isType)(const FEMaterialPoint*));
+
+	// returns the slot of data type T
+	template <class T> static int DataSlot() { static int slot = NewDataSlot(&IsDataType<T>); return slot; }
+
+	// see if a material point is of type T
+	template <class T> static bool IsDataType(const FEMaterialPoint* pt) { return (dynamic_cast<const T*>(pt) != 0); }
+
+	template <class T> static T* CastData(FEMaterialPoint* pt, std::true_type) { return static_cast<T*>(pt); }
+	template <class T> static T* CastData(FEMaterialPoint* pt, std::false_type) { return dynamic_cast<T*>(pt); }
+
+	// The cache of a point stores its layout and the points of its list, so that 
+	// the data can be found with a look-up. It is published atomically, since points
+	// can be accessed by several threads. A cache that is replaced is kept (in m_prev)
+	// until the point is deleted, since other threads may still be using it. 
+	struct Cache
+	{
+		Layout*		m_layout;	//!< layout of this point
+		int			m_gen;		//!< generation of the layout
+		int			m_up;		//!< number of points up the list
+		vector<FEMaterialPoint*>	m_item;	//!< the points of the list, starting at the top
+		Cache*		m_prev;		//!< the cache this cache replaced
+	};
+
+	// find the data (and create the cache of this point if necessary)
+	FEMaterialPoint* FindData(int slot, bool (*isType)(const FEMaterialPoint*));
+
+	// search the list for the data
+	int SearchData(bool (*isType)(const FEMaterialPoint*));
+
+	// find (or create) the layout of this point
+	Layout* FindLayout();
+
+	// see if this point, the points down the list, or their components have cached a layout
+	bool HasCachedLayout();
+
+	// Called when the list of pt was modified. If a point in the list has already cached
+	// its layout, all layouts are invalidated. New lists (e.g. temporary points) don't 
+	// have cached layouts, so building them does not affect the layouts in use.
+	static void ListChanged(FEMaterialPoint* pt);
+
+private:
+	std::atomic<Cache*>	m_cache;	//!< cached layout of this point
+
+	static std::atomic<int>	m_layoutGeneration;
 };
 
 //-----------------------------------------------------------------------------
+// Find the data of type T in the list of material points. The first time a 
+// type is requested, the list is searched (first down, then up) and the 
+// position of the data is stored in the point's layout. Later calls only need
+// a look-up in the point's cache. 
 template <class T> inline T* FEMaterialPoint::ExtractData()
 {
-	// first see if this is the correct type
-	T* p = dynamic_cast<T*>(this);
-	if (p) return p;
-
-	// check all the child classes 
-	FEMaterialPoint* pt = this;
-	while (pt->m_pNext)
-	{
-		pt = pt->m_pNext;
-		p = dynamic_cast<T*>(pt);
-		if (p) return p;
-	}
-
-	// search up
-	pt = this;
-	while (pt->m_pPrev)
-	{
-		pt = pt->m_pPrev;
-		p = dynamic_cast<T*>(pt);
-		if (p) return p;
-	}
+	const int slot = DataSlot<T>();
+	FEMaterialPoint* pt = 0;
+	const Cache* c = m_cache.load(std::memory_order_acquire);
+	int n = DATA_NOT_SEARCHED;
+	if (c && (c->m_gen == m_layoutGeneration.load(std::memory_order_relaxed)) && (slot < MAX_DATA_SLOTS)) n = c->m_layout->m_offset[slot].load(std::memory_order_relaxed);
+	if (n == DATA_NOT_SEARCHED) pt = FindData(slot, &IsDataType<T>);
+	else if (n != DATA_NOT_FOUND) pt = c->m_item[c->m_up + n];
 
 	// Everything has failed. Material point data can not be found
-	return 0;
+	if (pt == 0) return 0;
+
+	return CastData<T>(pt, std::is_base_of<FEMaterialPoint, T>());
 }
 
 //-----------------------------------------------------------------------------
 template <class T> inline const T* FEMaterialPoint::ExtractData() const
 {
-	// first see if this is the correct type
-	const T* p = dynamic_cast<const T*>(this);
-	if (p) return p;
-
-	// check all the child classes 
-	const FEMaterialPoint* pt = this;
-	while (pt->m_pNext)
-	{
-		pt = pt->m_pNext;
-		p = dynamic_cast<const T*>(pt);
-		if (p) return p;
-	}
-
-	// search up
-	pt = this;
-	while (pt->m_pPrev)
-	{
-		pt = pt->m_pPrev;
-		p = dynamic_cast<const T*>(pt);
-		if (p) return p;
-	}
-
-	// Everything has failed. Material point data can not be found
-	return 0;
+	return const_cast<FEMaterialPoint*>(this)->ExtractData<T>();
 }
 
-
 //-----------------------------------------------------------------------------
 // Material point base class for materials that define vector properties
 class FECORE_API FEMaterialPointArray : public FEMaterialPoint
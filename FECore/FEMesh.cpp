@@ -90,12 +90,16 @@ void FEMesh::Serialize(DumpStream& ar)
 
 	// we don't want to store pointers to all the nodes
 	// mostly for efficiency, so we tell the archive not to store the pointers
-	ar.LockPointerTable();
+	// (For checkpoints, the nodal data is stored separately.)
+	if (ar.IsCheckpoint() == false)
 	{
-		// store the node list
-		ar & m_Node;
+		ar.LockPointerTable();
+		{
+			// store the node list
+			ar & m_Node;
+		}
+		ar.UnlockPointerTable();
 	}
-	ar.UnlockPointerTable();
 
 	// stream domain data
 	ar & m_Domain;
@@ -616,6 +620,32 @@ FESolidElement* FEMesh::FindSolidElement(vec3d y, double r[3])
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+// Find the elements for a list of points
+void FEMesh::FindSolidElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r)
+{
+	// build the search structures before we start searching in parallel
+	for (int i = 0; i < Domains(); ++i)
+	{
+		if (m_Domain[i]->Class() == FE_DOMAIN_SOLID)
+		{
+			FESolidDomain& bd = static_cast<FESolidDomain&>(*m_Domain[i]);
+			bd.InitElementSearch();
+		}
+	}
+
+	int N = (int)y.size();
+	el.resize(N);
+	r.resize(N);
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < N; ++i)
+	{
+		double q[3] = { 0, 0, 0 };
+		el[i] = FindSolidElement(y[i], q);
+		r[i] = vec3d(q[0], q[1], q[2]);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEMesh::ClearDomains()
 {
@@ -870,7 +900,14 @@ void FEMesh::Update(const FETimeInfo& tp)
 	for (int i = 0; i<Domains(); ++i)
 	{
 		FEDomain& dom = Domain(i);
+
+		// evaluate the cached shape function gradients for the new configuration
+		if (dom.IsActive() && (dom.Class() == FE_DOMAIN_SOLID)) static_cast<FESolidDomain&>(dom).UpdateGradientCache();
+
 		if (dom.IsActive()) dom.Update(tp);
+
+		// update the point location search structures
+		if (dom.Class() == FE_DOMAIN_SOLID) static_cast<FESolidDomain&>(dom).UpdateElementSearch();
 	}
 }
 
@@ -130,6 +130,11 @@ public:
 	//! Finds the solid element in which y lies
 	FESolidElement* FindSolidElement(vec3d y, double r[3]);
 
+	//! Finds the solid elements for a list of points (in parallel). For each point, el 
+	//! is the element (or null if the point is not inside the mesh) and r are the 
+	//! isoparametric coordinates.
+	void FindSolidElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r);
+
 	FENodeElemList& NodeElementList()
 	{
 		if (m_NEL.Size() != m_Node.size()) m_NEL.Create(*this);
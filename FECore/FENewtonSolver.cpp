@@ -38,6 +38,7 @@ SOFTWARE.*/
 #include "sys.h"
 #include "FEDomain.h"
 #include "DumpStream.h"
+#include "FEProfiler.h"
 #include "FELinearSystem.h"
 
 //-----------------------------------------------------------------------------
@@ -191,6 +192,7 @@ bool FENewtonSolver::ReformStiffness()
 	bool bret = false;
 	{
 		TRACK_TIME(TimerID::Timer_Stiffness);
+		FE_PROFILE("stiffness");
 
 		// zero the stiffness matrix
 		m_pK->Zero();
@@ -227,6 +229,7 @@ bool FENewtonSolver::ReformStiffness()
     {
         {
 			TRACK_TIME(TimerID::Timer_Solve);
+			FE_PROFILE("factor");
 			// factorize the stiffness matrix
 			if (m_plinsolve->Factor() == false)
 			{
@@ -237,6 +240,7 @@ bool FENewtonSolver::ReformStiffness()
         // increase total nr of reformations
         m_nref++;
         m_ntotref++;
+		FEProfiler::GetInstance()->AddCount("reformations");
         
         // reset bfgs update counter
 		m_qnstrategy->m_nups = 0;
@@ -266,42 +270,56 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 {
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
-		// clean up the solver
-		m_plinsolve->Destroy();
+		FE_PROFILE("reform");
 
-		// clean up the stiffness matrix
-		m_pK->Clear();
-
-		// create the stiffness matrix
 		feLog("===== reforming stiffness matrix:\n");
-		if (m_pK->Create(GetFEModel(), m_neq, breset) == false)
+
+		// build the matrix profile and see if it changed.
+		// If not, we can keep the sparse matrix and the linear solver's 
+		// symbolic factorization and only need to redo the numeric factorization.
+		bool bchanged = m_pK->BuildProfile(GetFEModel(), m_neq, breset);
+
+		if (bchanged)
 		{
-			feLogError("An error occured while building the stiffness matrix\n\n");
-			return false;
+			// clean up the solver
+			m_plinsolve->Destroy();
+
+			// clean up the stiffness matrix
+			m_pK->Clear();
+
+			// create the stiffness matrix
+			m_pK->CreateFromProfile(GetFEModel());
+
+			FEProfiler* prof = FEProfiler::GetInstance();
+			prof->AddCount("matrix allocations");
+			prof->SetValue("matrix nonzeroes", m_pK->NonZeroes());
 		}
-		else
+		else FEProfiler::GetInstance()->AddCount("matrix profile reuses");
+
+		// output some information about the direct linear solver
+		int neq = m_pK->Rows();
+		int nnz = m_pK->NonZeroes();
+		feLog("\tNr of equations ........................... : %d\n", neq);
+		feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
+
+		int parts = m_plinsolve->Partitions();
+		if (parts > 1)
 		{
-			// output some information about the direct linear solver
-			int neq = m_pK->Rows();
-			int nnz = m_pK->NonZeroes();
-			feLog("\tNr of equations ........................... : %d\n", neq);
-			feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
-
-			int parts = m_plinsolve->Partitions();
-			if (parts > 1)
+			feLog("\tNr of partitions .......................... : %d\n", parts);
+			for (int i = 0; i < parts; ++i)
 			{
-				feLog("\tNr of partitions .......................... : %d\n", parts);
-				for (int i = 0; i < parts; ++i)
-				{
-					feLog("\t\tpartition %d ............................ : %d\n", i+1, m_plinsolve->GetPartitionSize(i));
-				}
+				feLog("\t\tpartition %d ............................ : %d\n", i+1, m_plinsolve->GetPartitionSize(i));
 			}
 		}
+
+		// the solver's preprocessing is still valid if the profile did not change
+		if (bchanged == false) return true;
 	}
 
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE("reorder");
 		if (!m_plinsolve->PreProcess())
 		{
 			feLogError("An error occurred during preprocessing of linear solver");
@@ -393,6 +411,7 @@ bool FENewtonSolver::AllocateLinearSystem()
 		feLogError("Failed allocating stiffness matrix.");
 		return false;
 	}
+	m_pK->SetUseAssemblyMap(m_bassemblyMap);
 
 	return true;
 }
@@ -846,6 +865,7 @@ bool FENewtonSolver::QNInit()
 	// calculate initial residual
 	{
 		TRACK_TIME(TimerID::Timer_Residual);
+		FE_PROFILE("residual");
 		if (m_qnstrategy->Residual(m_R0, true) == false) return false;
 	}
 
@@ -870,6 +890,7 @@ void FENewtonSolver::SolveEquations(std::vector<double>& u, std::vector<double>&
 {
 	// call the strategy to solve the linear equations
 	TRACK_TIME(TimerID::Timer_Solve);
+	FE_PROFILE("backsolve");
 
 	// for iterative solvers, we pass the last solution as the initial guess
 	if (m_plinsolve->IsIterative())
@@ -950,18 +971,24 @@ double FENewtonSolver::DoLineSearch()
 {
 	// the geometry is also updated in the line search
 	m_ls = 1.0;
-	if (m_lineSearch && (m_lineSearch->m_LStol > 0.0)) m_ls = m_lineSearch->DoLineSearch();
+	if (m_lineSearch && (m_lineSearch->m_LStol > 0.0))
+	{
+		FE_PROFILE("line search");
+		m_ls = m_lineSearch->DoLineSearch();
+	}
 	else
 	{
 		// Update geometry
 		{
 			TRACK_TIME(TimerID::Timer_Update);
+			FE_PROFILE("update");
 			Update(m_ui);
 		}
 
 		// calculate residual at this point
 		{
 			TRACK_TIME(TimerID::Timer_Residual);
+			FE_PROFILE("residual");
 			m_qnstrategy->Residual(m_R1, false);
 		}
 	}
@@ -1000,6 +1027,7 @@ bool FENewtonSolver::QNUpdate()
 	if (breform == false)
 	{
 		TRACK_TIME(TimerID::Timer_QNUpdate);
+		FE_PROFILE("qn update");
 
 		// make sure we didn't reach max updates
 		if (m_qnstrategy->m_nups >= m_qnstrategy->m_maxups - 1)
@@ -1073,6 +1101,7 @@ bool FENewtonSolver::DoAugmentations()
 		UpdateModel();
 		{
 			TRACK_TIME(TimerID::Timer_Residual);
+			FE_PROFILE("residual");
 			Residual(m_R0);
 		}
 
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FENode.h"
 #include "DumpStream.h"
+#include <string.h>
 
 //=============================================================================
 // FENode
@@ -127,6 +128,45 @@ void FENode::Serialize(DumpStream& ar)
 	}
 }
 
+//-----------------------------------------------------------------------------
+int FENode::StateSize() const
+{
+	return 21 + (int)(m_Fr.size() + m_val_t.size() + m_val_p.size());
+}
+
+//-----------------------------------------------------------------------------
+// helper functions for copying the node state
+static void CopyVec3d(vec3d& r, double*& pd, bool bsave)
+{
+	if (bsave) { pd[0] = r.x; pd[1] = r.y; pd[2] = r.z; }
+	else r = vec3d(pd[0], pd[1], pd[2]);
+	pd += 3;
+}
+
+static void CopyVector(std::vector<double>& v, double*& pd, bool bsave)
+{
+	size_t n = v.size();
+	if (n == 0) return;
+	if (bsave) memcpy(pd, &v[0], n*sizeof(double));
+	else memcpy(&v[0], pd, n*sizeof(double));
+	pd += n;
+}
+
+//-----------------------------------------------------------------------------
+void FENode::CopyState(double*& pd, bool bsave)
+{
+	CopyVec3d(m_rt, pd, bsave);
+	CopyVec3d(m_at, pd, bsave);
+	CopyVec3d(m_rp, pd, bsave);
+	CopyVec3d(m_vp, pd, bsave);
+	CopyVec3d(m_ap, pd, bsave);
+	CopyVec3d(m_dt, pd, bsave);
+	CopyVec3d(m_dp, pd, bsave);
+	CopyVector(m_Fr, pd, bsave);
+	CopyVector(m_val_t, pd, bsave);
+	CopyVector(m_val_p, pd, bsave);
+}
+
 //-----------------------------------------------------------------------------
 //! Update nodal values, which copies the current values to the previous array
 void FENode::UpdateValues()
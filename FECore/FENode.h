@@ -93,6 +93,14 @@ public:
 	// Serialize
 	void Serialize(DumpStream& ar);
 
+	//! Number of values (doubles) that CopyState copies
+	int StateSize() const;
+
+	//! Copy the data that a shallow Serialize stores (except the ID, which doesn't 
+	//! change) to (bsave = true) or from (bsave = false) a buffer. The buffer pointer
+	//! is advanced by StateSize().
+	void CopyState(double*& pd, bool bsave);
+
 	//! Update nodal values, which copies the current values to the previous array
 	void UpdateValues();
 
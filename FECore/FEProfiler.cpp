@@ -0,0 +1,332 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEProfiler.h"
+#include <string.h>
+#include <assert.h>
+#include <omp.h>
+using namespace std;
+
+FEProfiler* FEProfiler::m_pThis = nullptr;
+
+//-----------------------------------------------------------------------------
+FEProfiler* FEProfiler::GetInstance()
+{
+	if (m_pThis == nullptr) m_pThis = new FEProfiler;
+	return m_pThis;
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::FEProfiler()
+{
+	m_benabled = false;
+	m_brecordSteps = false;
+	Reset();
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Enable(bool b)
+{
+	m_benabled = b;
+	m_thread = std::this_thread::get_id();
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Reset()
+{
+	m_node.clear();
+	m_stack.clear();
+	m_start.clear();
+	m_steps.clear();
+	m_counter.clear();
+
+	// add the root
+	NODE root;
+	root.parent = -1;
+	root.calls = 0;
+	root.time = 0.0;
+	m_node.push_back(root);
+	m_stack.push_back(0);
+	m_start.push_back(Clock::now());
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::FindChild(int parent, const char* szname) const
+{
+	const vector<int>& children = m_node[parent].children;
+	for (size_t i = 0; i < children.size(); ++i)
+	{
+		int n = children[i];
+		if (m_node[n].name == szname) return n;
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::Enter(const char* szname, const char* szqualifier)
+{
+	// we only record timers on the main thread and outside parallel regions
+	if ((m_benabled == false) || omp_in_parallel() || (std::this_thread::get_id() != m_thread)) return -1;
+
+	char szbuf[256] = { 0 };
+	if (szqualifier)
+	{
+		snprintf(szbuf, sizeof(szbuf), "%s (%s)", szname, szqualifier);
+		szname = szbuf;
+	}
+
+	int parent = m_stack.back();
+	int n = FindChild(parent, szname);
+	if (n == -1)
+	{
+		NODE node;
+		node.name = szname;
+		node.parent = parent;
+		node.calls = 0;
+		node.time = 0.0;
+		n = (int)m_node.size();
+		m_node.push_back(node);
+		m_node[parent].children.push_back(n);
+	}
+	m_node[n].calls++;
+
+	m_stack.push_back(n);
+	m_start.push_back(Clock::now());
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Leave(int id)
+{
+	// timers should be stopped in the reverse order they were started
+	assert(m_stack.back() == id);
+	if ((m_stack.size() < 2) || (m_stack.back() != id)) return;
+
+	std::chrono::duration<double> dt = Clock::now() - m_start.back();
+	m_node[id].time += dt.count();
+
+	m_stack.pop_back();
+	m_start.pop_back();
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::COUNTER& FEProfiler::FindCounter(const char* szname)
+{
+	for (size_t i = 0; i < m_counter.size(); ++i)
+	{
+		if (m_counter[i].name == szname) return m_counter[i];
+	}
+	COUNTER c;
+	c.name = szname;
+	c.value = 0.0;
+	m_counter.push_back(c);
+	return m_counter.back();
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::AddCount(const char* szname, double v)
+{
+	if (m_benabled == false) return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	FindCounter(szname).value += v;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::SetValue(const char* szname, double v)
+{
+	if (m_benabled == false) return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	FindCounter(szname).value = v;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::RecordTimeStep(int step, double time)
+{
+	if ((m_benabled == false) || (m_brecordSteps == false)) return;
+
+	TIME_STEP ts;
+	ts.step = step;
+	ts.time = time;
+
+	// running timers include the time up to now
+	Clock::time_point now = Clock::now();
+	ts.calls.resize(m_node.size());
+	ts.timer.resize(m_node.size());
+	for (size_t i = 0; i < m_node.size(); ++i)
+	{
+		ts.calls[i] = m_node[i].calls;
+		ts.timer[i] = m_node[i].time;
+	}
+	for (size_t i = 1; i < m_stack.size(); ++i)
+	{
+		std::chrono::duration<double> dt = now - m_start[i];
+		ts.timer[m_stack[i]] += dt.count();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	ts.counter.resize(m_counter.size());
+	for (size_t i = 0; i < m_counter.size(); ++i) ts.counter[i] = m_counter[i].value;
+
+	m_steps.push_back(ts);
+}
+
+//-----------------------------------------------------------------------------
+std::string FEProfiler::TimerPath(int node) const
+{
+	std::string path = m_node[node].name;
+	for (int n = m_node[node].parent; n > 0; n = m_node[n].parent)
+	{
+		path = m_node[n].name + "/" + path;
+	}
+	return path;
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteReport(const char* szfile)
+{
+	if ((szfile == nullptr) || (szfile[0] == 0)) return false;
+
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	bool bret = false;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const char* szext = strrchr(szfile, '.');
+	if (szext && ((strcmp(szext, ".csv") == 0) || (strcmp(szext, ".CSV") == 0))) bret = WriteCSV(fp);
+	else bret = WriteJSON(fp);
+
+	fclose(fp);
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::WriteJSONTimer(FILE* fp, int node, int level) const
+{
+	const NODE& n = m_node[node];
+
+	// the self time is the time not spent in any of the children
+	double self = n.time;
+	for (size_t i = 0; i < n.children.size(); ++i) self -= m_node[n.children[i]].time;
+
+	fprintf(fp, "%*s{ \"name\": \"%s\", \"calls\": %d, \"time\": %lg, \"self\": %lg", 2*level, "", n.name.c_str(), n.calls, n.time, self);
+	if (n.children.empty() == false)
+	{
+		fprintf(fp, ", \"children\": [\n");
+		for (size_t i = 0; i < n.children.size(); ++i)
+		{
+			WriteJSONTimer(fp, n.children[i], level + 1);
+			fprintf(fp, "%s\n", (i + 1 < n.children.size() ? "," : ""));
+		}
+		fprintf(fp, "%*s]", 2*level, "");
+	}
+	fprintf(fp, " }");
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteJSON(FILE* fp) const
+{
+	const NODE& root = m_node[0];
+	fprintf(fp, "{\n");
+
+	// the timer tree
+	fprintf(fp, "  \"timers\": [\n");
+	for (size_t i = 0; i < root.children.size(); ++i)
+	{
+		WriteJSONTimer(fp, root.children[i], 2);
+		fprintf(fp, "%s\n", (i + 1 < root.children.size() ? "," : ""));
+	}
+	fprintf(fp, "  ],\n");
+
+	// counters
+	fprintf(fp, "  \"counters\": {");
+	for (size_t i = 0; i < m_counter.size(); ++i)
+	{
+		fprintf(fp, "%s\n    \"%s\": %.15lg", (i > 0 ? "," : ""), m_counter[i].name.c_str(), m_counter[i].value);
+	}
+	fprintf(fp, "\n  }");
+
+	// time step data
+	if (m_steps.empty() == false)
+	{
+		fprintf(fp, ",\n  \"time_steps\": [\n");
+		for (size_t i = 0; i < m_steps.size(); ++i)
+		{
+			const TIME_STEP& ts = m_steps[i];
+			fprintf(fp, "    { \"step\": %d, \"time\": %lg, \"timers\": {", ts.step, ts.time);
+			for (size_t j = 1; j < ts.timer.size(); ++j)
+			{
+				fprintf(fp, "%s \"%s\": %lg", (j > 1 ? "," : ""), TimerPath((int)j).c_str(), ts.timer[j]);
+			}
+			fprintf(fp, " }, \"counters\": {");
+			for (size_t j = 0; j < ts.counter.size(); ++j)
+			{
+				fprintf(fp, "%s \"%s\": %.15lg", (j > 0 ? "," : ""), m_counter[j].name.c_str(), ts.counter[j]);
+			}
+			fprintf(fp, " } }%s\n", (i + 1 < m_steps.size() ? "," : ""));
+		}
+		fprintf(fp, "  ]");
+	}
+	fprintf(fp, "\n}\n");
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteCSV(FILE* fp) const
+{
+	fprintf(fp, "step,time,type,name,calls,value\n");
+
+	// totals
+	for (size_t i = 1; i < m_node.size(); ++i)
+	{
+		fprintf(fp, "total,,timer,\"%s\",%d,%lg\n", TimerPath((int)i).c_str(), m_node[i].calls, m_node[i].time);
+	}
+	for (size_t i = 0; i < m_counter.size(); ++i)
+	{
+		fprintf(fp, "total,,counter,\"%s\",,%.15lg\n", m_counter[i].name.c_str(), m_counter[i].value);
+	}
+
+	// time step data
+	for (size_t n = 0; n < m_steps.size(); ++n)
+	{
+		const TIME_STEP& ts = m_steps[n];
+		for (size_t i = 1; i < ts.timer.size(); ++i)
+		{
+			fprintf(fp, "%d,%lg,timer,\"%s\",%d,%lg\n", ts.step, ts.time, TimerPath((int)i).c_str(), ts.calls[i], ts.timer[i]);
+		}
+		for (size_t i = 0; i < ts.counter.size(); ++i)
+		{
+			fprintf(fp, "%d,%lg,counter,\"%s\",,%.15lg\n", ts.step, ts.time, m_counter[i].name.c_str(), ts.counter[i]);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,168 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <stdio.h>
+
+//-----------------------------------------------------------------------------
+//! The profiler collects timing and counter data for a run. Timers are nested:
+//! a timer that is started while another timer is running becomes a child of 
+//! that timer, which builds up a tree of the time spent in the different phases
+//! of the solution process. 
+//! Only the thread that enabled the profiler records timers, and timers that are
+//! started inside an OpenMP parallel region are ignored. Counters can be updated
+//! from any thread.
+class FECORE_API FEProfiler
+{
+	struct NODE
+	{
+		std::string			name;		// name of timer
+		int					parent;		// parent timer (-1 for root)
+		std::vector<int>	children;	// child timers
+		int					calls;		// nr of times the timer was started
+		double				time;		// total time (in seconds)
+	};
+
+	struct COUNTER
+	{
+		std::string	name;
+		double		value;
+	};
+
+	struct TIME_STEP
+	{
+		int						step;
+		double					time;
+		std::vector<int>		calls;		// timer calls (for each node)
+		std::vector<double>		timer;		// timer values (for each node)
+		std::vector<double>		counter;	// counter values
+	};
+
+	typedef std::chrono::steady_clock	Clock;
+
+public:
+	//! return the profiler
+	static FEProfiler* GetInstance();
+
+	//! enable or disable the profiler. 
+	//! Timers are recorded for the thread that calls this function.
+	void Enable(bool b);
+
+	//! see if the profiler is enabled
+	bool IsEnabled() const { return m_benabled; }
+
+	//! set whether the data for each time step should be recorded
+	void RecordTimeSteps(bool b) { m_brecordSteps = b; }
+
+	//! see if the data is recorded for each time step
+	bool RecordingTimeSteps() const { return m_brecordSteps; }
+
+	//! clear all data
+	void Reset();
+
+public:
+	//! Start a timer with the given name (and optional qualifier) as a child of the 
+	//! currently running timer. Returns an id that must be passed to Leave, or -1 if 
+	//! the timer is not recorded.
+	int Enter(const char* szname, const char* szqualifier = nullptr);
+
+	//! Stop the timer that was started with Enter
+	void Leave(int id);
+
+	//! add a value to a counter
+	void AddCount(const char* szname, double v = 1.0);
+
+	//! set the value of a counter
+	void SetValue(const char* szname, double v);
+
+	//! store the current values of all timers and counters for a time step
+	void RecordTimeStep(int step, double time);
+
+public:
+	//! Write a report. The format is determined from the file extension:
+	//! ".csv" writes a CSV file, otherwise a JSON file is written.
+	bool WriteReport(const char* szfile);
+
+private:
+	FEProfiler();
+	FEProfiler(const FEProfiler&) {}
+
+	int FindChild(int parent, const char* szname) const;
+	COUNTER& FindCounter(const char* szname);
+
+	void WriteJSONTimer(FILE* fp, int node, int level) const;
+	bool WriteJSON(FILE* fp) const;
+	bool WriteCSV(FILE* fp) const;
+	std::string TimerPath(int node) const;
+
+private:
+	bool	m_benabled;		//!< profiler enabled or not
+	bool	m_brecordSteps;	//!< record data for each time step
+
+	std::thread::id			m_thread;	//!< the thread that records timers
+	std::vector<NODE>		m_node;		//!< all timers (root is at 0)
+	std::vector<int>		m_stack;	//!< stack of running timers
+	std::vector<Clock::time_point>	m_start;	//!< start times of running timers
+
+	std::vector<COUNTER>	m_counter;	//!< counters
+	std::mutex				m_mutex;	//!< protects the counters
+
+	std::vector<TIME_STEP>	m_steps;	//!< data for each time step
+
+	static FEProfiler*	m_pThis;
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class that records the time spent in a scope
+class FEProfileScope
+{
+public:
+	FEProfileScope(const char* szname, const char* szqualifier = nullptr)
+	{
+		FEProfiler* prof = FEProfiler::GetInstance();
+		m_id = (prof->IsEnabled() ? prof->Enter(szname, szqualifier) : -1);
+	}
+
+	~FEProfileScope()
+	{
+		if (m_id >= 0) FEProfiler::GetInstance()->Leave(m_id);
+	}
+
+private:
+	int	m_id;
+};
+
+#define FE_PROFILE(szname) FEProfileScope _profileScope(szname);
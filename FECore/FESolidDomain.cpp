@@ -31,6 +31,8 @@ SOFTWARE.*/
 #include "FEMaterial.h"
 #include "tools.h"
 #include "log.h"
+#include "FEElementBVH.h"
+#include "FESolidElementKernel.h"
 
 //-----------------------------------------------------------------------------
 FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m_dofU(pfem), m_dofSU(pfem)
@@ -44,11 +46,28 @@ FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m
 		m_dofSU.AddDof(pfem->GetDOFIndex("sy"));
 		m_dofSU.AddDof(pfem->GetDOFIndex("sz"));
 	}
+	m_bvh = nullptr;
+	m_kernel = 0;
+	m_bgcache = false;
+	m_gcTag = -1;
+}
+
+//-----------------------------------------------------------------------------
+FESolidDomain::~FESolidDomain()
+{
+	delete m_bvh.load();
 }
 
 //-----------------------------------------------------------------------------
 bool FESolidDomain::Create(int nsize, FE_Element_Spec espec)
 {
+	// the search structure is no longer valid
+	delete m_bvh.exchange(nullptr);
+
+	// release the material point data of the old elements
+	ForEachElement([](FEElement& el) { if (el.GetTraits()) el.ClearData(); });
+	m_mpPool.Clear();
+
 	// allocate elements
     m_Elem.resize(nsize);
 	for (int i = 0; i < nsize; ++i)
@@ -64,6 +83,10 @@ bool FESolidDomain::Create(int nsize, FE_Element_Spec espec)
 
 	m_elemSpec = espec;
 
+	// the gradient cache needs to be reallocated
+	m_gcTag = -1;
+	m_gcPoint.clear();
+
 	return true;
 }
 
@@ -94,9 +117,28 @@ void FESolidDomain::CopyFrom(FEMeshPartition* pd)
 	FEDomain::CopyFrom(pd);
 	FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pd);
     m_Elem = psd->m_Elem;
+	m_kernel = psd->m_kernel;
+	m_bgcache = psd->m_bgcache;
+	m_gcTag = -1;
 	ForEachElement([=](FEElement& el) { el.SetMeshPartition(this); });
 }
 
+//-----------------------------------------------------------------------------
+// The material point data is allocated from the domain's memory pool. This
+// way the data of the integration points is stored contiguously (in element
+// order), which improves the memory access pattern of the element loops.
+void FESolidDomain::CreateMaterialPointData()
+{
+	// delete the old data first, so that the pool's memory can be reused
+	ForEachElement([](FEElement& el) { el.ClearData(); });
+	m_mpPool.Clear();
+
+	FEMaterialPointPool* prev = FEMaterialPointPool::Active();
+	FEMaterialPointPool::SetActive(&m_mpPool);
+	FEDomain::CreateMaterialPointData();
+	FEMaterialPointPool::SetActive(prev);
+}
+
 //-----------------------------------------------------------------------------
 //! initialize element data
 bool FESolidDomain::Init()
@@ -104,6 +146,20 @@ bool FESolidDomain::Init()
 	// base class first
 	if (FEDomain::Init() == false) return false;
 
+	// Select the fixed-size element kernel. This can only be done when all 
+	// elements have the same number of nodes.
+	m_kernel = 0;
+	int NE = Elements();
+	if (NE > 0)
+	{
+		int neln = m_Elem[0].Nodes();
+		for (int i = 1; i < NE; ++i)
+		{
+			if (m_Elem[i].Nodes() != neln) { neln = 0; break; }
+		}
+		m_kernel = FESolidKernel::Select(neln);
+	}
+
 	// init solid element data
 	// TODO: In principle I could parallelize this, but right now this cannot be done
 	//       because of the try block. 
@@ -147,6 +203,78 @@ bool FESolidDomain::Init()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::EnableGradientCache(bool b)
+{
+	m_bgcache = b;
+	m_gcTag = -1;
+	if (b == false)
+	{
+		m_gcPoint.clear(); m_gcNode.clear();
+		m_gcJ.clear(); m_gcJi.clear(); m_gcG.clear();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::UpdateGradientCache()
+{
+	if (m_bgcache == false) return;
+
+	// see if the cache is already up to date
+	int tag = GetFEModel()->UpdateCounter();
+	if (tag == m_gcTag) return;
+
+	// allocate the cache
+	int NE = Elements();
+	if ((int)m_gcPoint.size() != NE + 1)
+	{
+		m_gcPoint.assign(NE + 1, 0);
+		m_gcNode.assign(NE + 1, 0);
+		for (int i = 0; i < NE; ++i)
+		{
+			FESolidElement& el = m_Elem[i];
+			m_gcPoint[i + 1] = m_gcPoint[i] + el.GaussPoints();
+			m_gcNode[i + 1] = m_gcNode[i] + el.GaussPoints()*el.Nodes();
+		}
+		m_gcJ.resize(m_gcPoint[NE]);
+		m_gcJi.resize(m_gcPoint[NE]);
+		m_gcG.resize(m_gcNode[NE]);
+	}
+
+	// evaluate the jacobians and shape function gradients. 
+	// Note that a negative jacobian is stored, and only reported when it is used.
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+
+		vec3d rt[FEElement::MAX_NODES];
+		GetCurrentNodalCoordinates(el, rt);
+
+		for (int n = 0; n < nint; ++n)
+		{
+			int m = m_gcPoint[i] + n;
+			double Ji[3][3] = { 0 };
+			double det = FESolidKernel::invjac(m_kernel, neln, rt, el.Gr(n), el.Gs(n), el.Gt(n), Ji);
+			m_gcJ[m] = det;
+			m_gcJi[m] = mat3d(Ji);
+			if (det > 0) FESolidKernel::shapeGradient(m_kernel, neln, Ji, el.Gr(n), el.Gs(n), el.Gt(n), &m_gcG[m_gcNode[i] + n*neln]);
+		}
+	}
+
+	m_gcTag = tag;
+}
+
+//-----------------------------------------------------------------------------
+int FESolidDomain::GradientCacheIndex(const FESolidElement& el, int n) const
+{
+	if ((m_gcTag < 0) || (m_gcTag != GetFEModel()->UpdateCounter())) return -1;
+	if (el.GetMeshPartition() != this) return -1;
+	return m_gcPoint[el.GetLocalID()] + n;
+}
+
 //-----------------------------------------------------------------------------
 // Reset data
 void FESolidDomain::Reset()
@@ -162,39 +290,53 @@ void FESolidDomain::Reset()
 //! (This has only been implemeneted for hexes!)
 FESolidElement* FESolidDomain::FindElement(const vec3d& y, double r[3])
 {
-    int i, j;
-    int NE = Elements();
-    vec3d x[FEElement::MAX_NODES];
-    for (i=0; i<NE; ++i)
-    {
-        // get the next element
-        FESolidElement& e = Element(i);
-        assert(e.Type() == FE_HEX8G8);
-        
-        // get the element nodal coordinates
-        int neln = e.Nodes();
-        for (j=0; j<neln; ++j) x[j] = m_pMesh->Node(e.m_node[j]).m_rt;
-        
-        // first, as a quick check, we see if y lies in the bounding box defined by x
-        FEBoundingBox box(x[0]);
-        for (j=1; j<neln; ++j) box.add(x[j]);
-        
-        if (box.IsInside(y))
-        {
-			// If the point y lies inside the box, we apply a Newton method to find
-			// the isoparametric coordinates r
-			ProjectToElement(e, y, r);
-            
-            // see if the point r lies inside the element
-            const double eps = 1.0001;
-            if ((r[0] >= -eps) && (r[0] <= eps) &&
-                (r[1] >= -eps) && (r[1] <= eps) &&
-                (r[2] >= -eps) && (r[2] <= eps)) return &e;
-        }
-    }
-    return 0;
+	// only elements whose bounding box contains y need to be checked
+	InitElementSearch();
+	static thread_local vector<int> elemList;
+	m_bvh.load(std::memory_order_acquire)->FindCandidates(y, elemList);
+
+	for (int i : elemList)
+	{
+		// get the next element
+		FESolidElement& e = Element(i);
+		assert(e.Type() == FE_HEX8G8);
+
+		// we apply a Newton method to find the isoparametric coordinates r
+		ProjectToElement(e, y, r);
+
+		// see if the point r lies inside the element
+		const double eps = 1.0001;
+		if ((r[0] >= -eps) && (r[0] <= eps) &&
+			(r[1] >= -eps) && (r[1] <= eps) &&
+			(r[2] >= -eps) && (r[2] <= eps)) return &e;
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// The search structure is built on first use, which may happen inside a parallel
+// loop, so only one thread builds it.
+void FESolidDomain::InitElementSearch()
+{
+	if (m_bvh.load(std::memory_order_acquire)) return;
+
+	#pragma omp critical (FESolidDomain_InitElementSearch)
+	{
+		if (m_bvh.load(std::memory_order_relaxed) == nullptr)
+		{
+			FEElementBVH* bvh = new FEElementBVH(this);
+			bvh->Build();
+			m_bvh.store(bvh, std::memory_order_release);
+		}
+	}
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::UpdateElementSearch()
+{
+	FEElementBVH* bvh = m_bvh.load();
+	if (bvh) bvh->Refit();
+}
 
 //-----------------------------------------------------------------------------
 //! This function finds the element in which point y lies and returns
@@ -456,43 +598,12 @@ double FESolidDomain::defgrad(FESolidElement &el, mat3d &F, int n)
     // nodal points
     vec3d r[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, r);
-    
-    // calculate inverse jacobian
-//    double Ji[3][3];
-//    invjac0(el, Ji, n);
-	mat3d& Ji = el.m_J0i[n];
 
-	// shape function derivatives
-	double *Grn = el.Gr(n);
-	double *Gsn = el.Gs(n);
-	double *Gtn = el.Gt(n);
+	// inverse reference jacobian
+	mat3d& Ji = el.m_J0i[n];
 
     // calculate deformation gradient
-	F[0][0] = F[0][1] = F[0][2] = 0;
-    F[1][0] = F[1][1] = F[1][2] = 0;
-    F[2][0] = F[2][1] = F[2][2] = 0;
-	int neln = el.Nodes();
-	for (int i = 0; i<neln; ++i)
-    {
-        double Gri = Grn[i];
-        double Gsi = Gsn[i];
-        double Gti = Gtn[i];
-        
-        double x = r[i].x;
-        double y = r[i].y;
-        double z = r[i].z;
-        
-        // calculate global gradient of shape functions
-        // note that we need the transposed of Ji, not Ji itself !
-        double GX = Ji[0][0]*Gri+Ji[1][0]*Gsi+Ji[2][0]*Gti;
-        double GY = Ji[0][1]*Gri+Ji[1][1]*Gsi+Ji[2][1]*Gti;
-        double GZ = Ji[0][2]*Gri+Ji[1][2]*Gsi+Ji[2][2]*Gti;
-        
-        // calculate deformation gradient F
-        F[0][0] += GX*x; F[0][1] += GY*x; F[0][2] += GZ*x;
-        F[1][0] += GX*y; F[1][1] += GY*y; F[1][2] += GZ*y;
-        F[2][0] += GX*z; F[2][1] += GY*z; F[2][2] += GZ*z;
-    }
+	FESolidKernel::defgrad(m_kernel, el.Nodes(), Ji, r, el.Gr(n), el.Gs(n), el.Gt(n), F);
     
     double D = F.det();
     if (D <= 0) throw NegativeJacobian(el.GetID(), n, D, &el);
@@ -1159,52 +1270,29 @@ double FESolidDomain::invjac0(const FESolidElement& el, double r, double s, doub
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n)
 {
+	// see if we can use the cached value
+	int m = GradientCacheIndex(el, n);
+	if (m >= 0)
+	{
+		double det = m_gcJ[m];
+		if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
+		const mat3d& Jm = m_gcJi[m];
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j) Ji[i][j] = Jm[i][j];
+		return det;
+	}
+
     // nodal coordinates
     vec3d rt[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, rt);
 
-    // calculate jacobian
-    double J[3][3] = {0};
-	int neln = el.Nodes();
-	for (int i = 0; i<neln; ++i)
-    {
-        const double& Gri = el.Gr(n)[i];
-        const double& Gsi = el.Gs(n)[i];
-        const double& Gti = el.Gt(n)[i];
-        
-        const double& x = rt[i].x;
-        const double& y = rt[i].y;
-        const double& z = rt[i].z;
-        
-        J[0][0] += Gri*x; J[0][1] += Gsi*x; J[0][2] += Gti*x;
-        J[1][0] += Gri*y; J[1][1] += Gsi*y; J[1][2] += Gti*y;
-        J[2][0] += Gri*z; J[2][1] += Gsi*z; J[2][2] += Gti*z;
-    }
-    
-    // calculate the determinant
-    double det =  J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
-				+ J[0][1]*(J[1][2]*J[2][0] - J[2][2]*J[1][0])
-				+ J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
-    
-    // make sure the determinant is positive
-    if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
-    
-    // calculate inverse jacobian
-    double deti = 1.0 / det;
-				
-    Ji[0][0] =  deti*(J[1][1]*J[2][2] - J[1][2]*J[2][1]);
-    Ji[1][0] =  deti*(J[1][2]*J[2][0] - J[1][0]*J[2][2]);
-    Ji[2][0] =  deti*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
-    
-    Ji[0][1] =  deti*(J[0][2]*J[2][1] - J[0][1]*J[2][2]);
-    Ji[1][1] =  deti*(J[0][0]*J[2][2] - J[0][2]*J[2][0]);
-    Ji[2][1] =  deti*(J[0][1]*J[2][0] - J[0][0]*J[2][1]);
-    
-    Ji[0][2] =  deti*(J[0][1]*J[1][2] - J[1][1]*J[0][2]);
-    Ji[1][2] =  deti*(J[0][2]*J[1][0] - J[0][0]*J[1][2]);
-    Ji[2][2] =  deti*(J[0][0]*J[1][1] - J[0][1]*J[1][0]);
-    
-    return det;
+	// calculate the jacobian and its inverse
+	double det = FESolidKernel::invjac(m_kernel, el.Nodes(), rt, el.Gr(n), el.Gs(n), el.Gt(n), Ji);
+
+	// make sure the determinant is positive
+	if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
+
+	return det;
 }
 
 //-----------------------------------------------------------------------------
@@ -1213,46 +1301,11 @@ double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n)
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n, const vec3d* rt)
 {
-	// calculate jacobian
-	double J[3][3] = { 0 };
-	int neln = el.Nodes();
-	for (int i = 0; i<neln; ++i)
-	{
-		const double& Gri = el.Gr(n)[i];
-		const double& Gsi = el.Gs(n)[i];
-		const double& Gti = el.Gt(n)[i];
-
-		const double& x = rt[i].x;
-		const double& y = rt[i].y;
-		const double& z = rt[i].z;
-
-		J[0][0] += Gri*x; J[0][1] += Gsi*x; J[0][2] += Gti*x;
-		J[1][0] += Gri*y; J[1][1] += Gsi*y; J[1][2] += Gti*y;
-		J[2][0] += Gri*z; J[2][1] += Gsi*z; J[2][2] += Gti*z;
-	}
-
-	// calculate the determinant
-	double det = J[0][0] * (J[1][1] * J[2][2] - J[1][2] * J[2][1])
-		+ J[0][1] * (J[1][2] * J[2][0] - J[2][2] * J[1][0])
-		+ J[0][2] * (J[1][0] * J[2][1] - J[1][1] * J[2][0]);
+	// calculate the jacobian and its inverse
+	double det = FESolidKernel::invjac(m_kernel, el.Nodes(), rt, el.Gr(n), el.Gs(n), el.Gt(n), Ji);
 
 	// make sure the determinant is positive
-	if (det <= 0) throw NegativeJacobian(el.GetID(), n + 1, det);
-
-	// calculate inverse jacobian
-	double deti = 1.0 / det;
-
-	Ji[0][0] = deti*(J[1][1] * J[2][2] - J[1][2] * J[2][1]);
-	Ji[1][0] = deti*(J[1][2] * J[2][0] - J[1][0] * J[2][2]);
-	Ji[2][0] = deti*(J[1][0] * J[2][1] - J[1][1] * J[2][0]);
-
-	Ji[0][1] = deti*(J[0][2] * J[2][1] - J[0][1] * J[2][2]);
-	Ji[1][1] = deti*(J[0][0] * J[2][2] - J[0][2] * J[2][0]);
-	Ji[2][1] = deti*(J[0][1] * J[2][0] - J[0][0] * J[2][1]);
-
-	Ji[0][2] = deti*(J[0][1] * J[1][2] - J[1][1] * J[0][2]);
-	Ji[1][2] = deti*(J[0][2] * J[1][0] - J[0][0] * J[1][2]);
-	Ji[2][2] = deti*(J[0][0] * J[1][1] - J[0][1] * J[1][0]);
+	if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
 
 	return det;
 }
@@ -1263,52 +1316,20 @@ double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n, const
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n, const double alpha)
 {
+	// the cache stores the data for the current configuration
+	if ((alpha == 1.0) && el.m_bitfc.empty() && (GradientCacheIndex(el, n) >= 0)) return invjact(el, Ji, n);
+
     // nodal coordinates
     vec3d rt[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, rt, alpha);
-    
-    // calculate jacobian
-	int neln = el.Nodes();
-	double J[3][3] = { 0 };
-    for (int i=0; i<neln; ++i)
-    {
-        const double& Gri = el.Gr(n)[i];
-        const double& Gsi = el.Gs(n)[i];
-        const double& Gti = el.Gt(n)[i];
-        
-        const double& x = rt[i].x;
-        const double& y = rt[i].y;
-        const double& z = rt[i].z;
-        
-        J[0][0] += Gri*x; J[0][1] += Gsi*x; J[0][2] += Gti*x;
-        J[1][0] += Gri*y; J[1][1] += Gsi*y; J[1][2] += Gti*y;
-        J[2][0] += Gri*z; J[2][1] += Gsi*z; J[2][2] += Gti*z;
-    }
-    
-    // calculate the determinant
-    double det =  J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
-				+ J[0][1]*(J[1][2]*J[2][0] - J[2][2]*J[1][0])
-				+ J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
-    
-    // make sure the determinant is positive
-    if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
-    
-    // calculate inverse jacobian
-    double deti = 1.0 / det;
-				
-    Ji[0][0] =  deti*(J[1][1]*J[2][2] - J[1][2]*J[2][1]);
-    Ji[1][0] =  deti*(J[1][2]*J[2][0] - J[1][0]*J[2][2]);
-    Ji[2][0] =  deti*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
-    
-    Ji[0][1] =  deti*(J[0][2]*J[2][1] - J[0][1]*J[2][2]);
-    Ji[1][1] =  deti*(J[0][0]*J[2][2] - J[0][2]*J[2][0]);
-    Ji[2][1] =  deti*(J[0][1]*J[2][0] - J[0][0]*J[2][1]);
-    
-    Ji[0][2] =  deti*(J[0][1]*J[1][2] - J[1][1]*J[0][2]);
-    Ji[1][2] =  deti*(J[0][2]*J[1][0] - J[0][0]*J[1][2]);
-    Ji[2][2] =  deti*(J[0][0]*J[1][1] - J[0][1]*J[1][0]);
-    
-    return det;
+
+	// calculate the jacobian and its inverse
+	double det = FESolidKernel::invjac(m_kernel, el.Nodes(), rt, el.Gr(n), el.Gs(n), el.Gt(n), Ji);
+
+	// make sure the determinant is positive
+	if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
+
+	return det;
 }
 
 //-----------------------------------------------------------------------------
@@ -1780,6 +1801,10 @@ tens3dls FESolidDomain::Gradient(FESolidElement& el, mat3ds* fn, int n)
 //! Calculate jacobian with respect to current frame
 double FESolidDomain::detJt(FESolidElement &el, int n)
 {
+	// see if we can use the cached value
+	int m = GradientCacheIndex(el, n);
+	if (m >= 0) return m_gcJ[m];
+
     // nodal coordinates
     vec3d rt[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, rt);
@@ -2296,24 +2321,24 @@ void FESolidDomain::gradTgradShape(FESolidElement& el, int j, vector<mat3d>& mn)
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH)
 {
+	// see if we can use the cached values
+	int m = GradientCacheIndex(el, n);
+	if (m >= 0)
+	{
+		double det = m_gcJ[m];
+		if (det <= 0) throw NegativeJacobian(el.GetID(), n+1, det);
+		int neln = el.Nodes();
+		const vec3d* G = &m_gcG[m_gcNode[el.GetLocalID()] + n*neln];
+		for (int i = 0; i < neln; ++i) GradH[i] = G[i];
+		return det;
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJt = invjact(el, Ji, n);
     
     // evaluate shape function derivatives
-    int ne = el.Nodes();
-    for (int i = 0; i<ne; ++i)
-    {
-        double Gr = el.Gr(n)[i];
-        double Gs = el.Gs(n)[i];
-        double Gt = el.Gt(n)[i];
-        
-        // calculate global gradient of shape functions
-        // note that we need the transposed of Ji, not Ji itself !
-        GradH[i].x = Ji[0][0] * Gr + Ji[1][0] * Gs + Ji[2][0] * Gt;
-        GradH[i].y = Ji[0][1] * Gr + Ji[1][1] * Gs + Ji[2][1] * Gt;
-        GradH[i].z = Ji[0][2] * Gr + Ji[1][2] * Gs + Ji[2][2] * Gt;
-    }
+	FESolidKernel::shapeGradient(m_kernel, el.Nodes(), Ji, el.Gr(n), el.Gs(n), el.Gt(n), GradH);
     
     return detJt;
 }
@@ -2321,24 +2346,15 @@ double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH)
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH, const double alpha)
 {
+	// the cache stores the data for the current configuration
+	if ((alpha == 1.0) && el.m_bitfc.empty() && (GradientCacheIndex(el, n) >= 0)) return ShapeGradient(el, n, GradH);
+
     // calculate jacobian
     double Ji[3][3];
     double detJt = invjact(el, Ji, n, alpha);
     
     // evaluate shape function derivatives
-    int ne = el.Nodes();
-    for (int i = 0; i<ne; ++i)
-    {
-        double Gr = el.Gr(n)[i];
-        double Gs = el.Gs(n)[i];
-        double Gt = el.Gt(n)[i];
-        
-        // calculate global gradient of shape functions
-        // note that we need the transposed of Ji, not Ji itself !
-        GradH[i].x = Ji[0][0] * Gr + Ji[1][0] * Gs + Ji[2][0] * Gt;
-        GradH[i].y = Ji[0][1] * Gr + Ji[1][1] * Gs + Ji[2][1] * Gt;
-        GradH[i].z = Ji[0][2] * Gr + Ji[1][2] * Gs + Ji[2][2] * Gt;
-    }
+	FESolidKernel::shapeGradient(m_kernel, el.Nodes(), Ji, el.Gr(n), el.Gs(n), el.Gt(n), GradH);
     
     return detJt;
 }
@@ -31,6 +31,9 @@ SOFTWARE.*/
 #include "FEModel.h"
 #include "FEDofList.h"
 #include "FELinearSystem.h"
+#include <atomic>
+
+class FEElementBVH;
 
 //-----------------------------------------------------------------------------
 // This typedef defines a surface integrand. 
@@ -49,6 +52,9 @@ class FECORE_API FESolidDomain : public FEDomain
 public:
     //! constructor
     FESolidDomain(FEModel* pfem);
+
+	//! destructor
+	~FESolidDomain();
     
     //! create storage for elements
 	bool Create(int nsize, FE_Element_Spec espec) override;
@@ -65,6 +71,9 @@ public:
     //! copy data from another domain (overridden from FEDomain)
     void CopyFrom(FEMeshPartition* pd) override;
 
+	//! Allocate material point data (from the domain's memory pool)
+	void CreateMaterialPointData() override;
+
     //! element access
 	FESolidElement& Element(int n);
     FEElement& ElementRef(int n) override { return m_Elem[n]; }
@@ -75,10 +84,31 @@ public:
     int GetElementShape() const { return m_Elem[0].Shape(); }
 
 	FE_Element_Spec GetElementSpec() const;
+
+	//! return the fixed-size element kernel that is used for this domain (0 = general kernel)
+	//! (see FESolidElementKernel.h)
+	int ElementKernel() const { return m_kernel; }
+
+	//! Enable the cache of the current jacobians and spatial shape function gradients. 
+	//! When enabled, these are evaluated at all integration points each time the model is
+	//! updated (see UpdateGradientCache), and reused by invjact, detJt and ShapeGradient 
+	//! until the next update. This requires (10 + 3*neln) doubles per integration point.
+	void EnableGradientCache(bool b);
+
+	//! Evaluate the cached jacobians and shape function gradients for the current 
+	//! configuration. Does nothing if the cache is disabled or already up to date.
+	void UpdateGradientCache();
     
     //! find the element in which point y lies
     FESolidElement* FindElement(const vec3d& y, double r[3]);
 
+	//! build the search structure used by FindElement (if it does not exist yet). 
+	//! This is called by FindElement, but it is safe to call from multiple threads.
+	void InitElementSearch();
+
+	//! update the search structure used by FindElement to the current nodal positions
+	void UpdateElementSearch();
+
 	//! find the element in which point y lies (reference configuration)
 	FESolidElement* FindReferenceElement(const vec3d& y, double r[3]);
 
@@ -279,9 +309,26 @@ public:
 	);
 
 protected:
+	FEMaterialPointPool		m_mpPool;	//!< memory pool for material point data (must be declared before m_Elem)
     vector<FESolidElement>	m_Elem;		//!< array of elements
 	FE_Element_Spec			m_elemSpec;	//!< the element spec
+	int						m_kernel;	//!< fixed-size element kernel (selected in Init)
 
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
+
+	std::atomic<FEElementBVH*>	m_bvh;	//!< search structure for point location (created on first use)
+
+private:
+	//! return the index of integration point n of el in the gradient cache (or -1 if the cache is not valid)
+	int GradientCacheIndex(const FESolidElement& el, int n) const;
+
+private:
+	bool			m_bgcache;	//!< use the gradient cache
+	int				m_gcTag;	//!< model update counter at which the cache was evaluated (-1 = not evaluated)
+	vector<int>		m_gcPoint;	//!< index of the first integration point of each element
+	vector<int>		m_gcNode;	//!< index of the first shape function gradient of each element
+	vector<double>	m_gcJ;		//!< jacobian determinants (at integration points)
+	vector<mat3d>	m_gcJi;		//!< inverse jacobians (at integration points)
+	vector<vec3d>	m_gcG;		//!< shape function gradients (for each node at integration points)
 };
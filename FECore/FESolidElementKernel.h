@@ -0,0 +1,344 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "mat3d.h"
+#include "matrix.h"
+
+//-----------------------------------------------------------------------------
+//! Fixed-size computational kernels for solid elements. 
+//! The template parameter is the number of element nodes. When it is non-zero 
+//! the loop bounds are compile-time constants, so the compiler can fully unroll
+//! and vectorize the loops over the nodes. The general case (NEL = 0) uses the
+//! runtime number of nodes (neln), which is ignored otherwise.
+//! The kernels perform the same operations (in the same order) as the general
+//! element routines of FESolidDomain, so the results do not depend on which 
+//! kernel is used.
+template <int NEL> class FESolidElementKernel
+{
+public:
+	//! Calculate the jacobian matrix (dx/dr) from the nodal coordinates and shape 
+	//! function derivatives. Returns the determinant of the jacobian and its inverse 
+	//! in Ji (when the determinant is positive).
+	static double invjac(int neln, const vec3d* r, const double* Gr, const double* Gs, const double* Gt, double Ji[3][3])
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+
+		double J[3][3] = { 0 };
+		for (int i = 0; i<N; ++i)
+		{
+			const double Gri = Gr[i];
+			const double Gsi = Gs[i];
+			const double Gti = Gt[i];
+
+			const double x = r[i].x;
+			const double y = r[i].y;
+			const double z = r[i].z;
+
+			J[0][0] += Gri*x; J[0][1] += Gsi*x; J[0][2] += Gti*x;
+			J[1][0] += Gri*y; J[1][1] += Gsi*y; J[1][2] += Gti*y;
+			J[2][0] += Gri*z; J[2][1] += Gsi*z; J[2][2] += Gti*z;
+		}
+
+		// calculate the determinant
+		double det =  J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
+					+ J[0][1]*(J[1][2]*J[2][0] - J[2][2]*J[1][0])
+					+ J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
+		if (det <= 0) return det;
+
+		// calculate inverse jacobian
+		double deti = 1.0 / det;
+
+		Ji[0][0] =  deti*(J[1][1]*J[2][2] - J[1][2]*J[2][1]);
+		Ji[1][0] =  deti*(J[1][2]*J[2][0] - J[1][0]*J[2][2]);
+		Ji[2][0] =  deti*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
+
+		Ji[0][1] =  deti*(J[0][2]*J[2][1] - J[0][1]*J[2][2]);
+		Ji[1][1] =  deti*(J[0][0]*J[2][2] - J[0][2]*J[2][0]);
+		Ji[2][1] =  deti*(J[0][1]*J[2][0] - J[0][0]*J[2][1]);
+
+		Ji[0][2] =  deti*(J[0][1]*J[1][2] - J[1][1]*J[0][2]);
+		Ji[1][2] =  deti*(J[0][2]*J[1][0] - J[0][0]*J[1][2]);
+		Ji[2][2] =  deti*(J[0][0]*J[1][1] - J[0][1]*J[1][0]);
+
+		return det;
+	}
+
+	//! Calculate the spatial gradients of the shape functions
+	static void shapeGradient(int neln, const double Ji[3][3], const double* Gr, const double* Gs, const double* Gt, vec3d* G)
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+		for (int i = 0; i<N; ++i)
+		{
+			// note that we need the transposed of Ji, not Ji itself !
+			G[i].x = Ji[0][0] * Gr[i] + Ji[1][0] * Gs[i] + Ji[2][0] * Gt[i];
+			G[i].y = Ji[0][1] * Gr[i] + Ji[1][1] * Gs[i] + Ji[2][1] * Gt[i];
+			G[i].z = Ji[0][2] * Gr[i] + Ji[1][2] * Gs[i] + Ji[2][2] * Gt[i];
+		}
+	}
+
+	//! Calculate the deformation gradient from the current nodal coordinates and
+	//! the inverse reference jacobian.
+	static void defgrad(int neln, const mat3d& Ji, const vec3d* r, const double* Gr, const double* Gs, const double* Gt, mat3d& F)
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+
+		double F00 = 0, F01 = 0, F02 = 0;
+		double F10 = 0, F11 = 0, F12 = 0;
+		double F20 = 0, F21 = 0, F22 = 0;
+		for (int i = 0; i<N; ++i)
+		{
+			const double Gri = Gr[i];
+			const double Gsi = Gs[i];
+			const double Gti = Gt[i];
+
+			const double x = r[i].x;
+			const double y = r[i].y;
+			const double z = r[i].z;
+
+			const double GX = Ji[0][0]*Gri+Ji[1][0]*Gsi+Ji[2][0]*Gti;
+			const double GY = Ji[0][1]*Gri+Ji[1][1]*Gsi+Ji[2][1]*Gti;
+			const double GZ = Ji[0][2]*Gri+Ji[1][2]*Gsi+Ji[2][2]*Gti;
+
+			F00 += GX*x; F01 += GY*x; F02 += GZ*x;
+			F10 += GX*y; F11 += GY*y; F12 += GZ*y;
+			F20 += GX*z; F21 += GY*z; F22 += GZ*z;
+		}
+
+		F[0][0] = F00; F[0][1] = F01; F[0][2] = F02;
+		F[1][0] = F10; F[1][1] = F11; F[1][2] = F12;
+		F[2][0] = F20; F[2][1] = F21; F[2][2] = F22;
+	}
+
+	//! Add the internal force contribution of an integration point to fe. 
+	//! G are the spatial shape function gradients, s the Cauchy stress, 
+	//! and w the integration weight (times the jacobian). 
+	static void internalForce(int neln, const vec3d* G, const mat3ds& s, double w, double* fe)
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+		for (int i = 0; i<N; ++i)
+		{
+			const double Gx = G[i].x;
+			const double Gy = G[i].y;
+			const double Gz = G[i].z;
+
+			// the '-' sign is so that the internal forces get subtracted
+			// from the global residual vector
+			fe[3*i  ] -= (Gx*s.xx() + Gy*s.xy() + Gz*s.xz())*w;
+			fe[3*i+1] -= (Gy*s.yy() + Gx*s.xy() + Gz*s.yz())*w;
+			fe[3*i+2] -= (Gz*s.zz() + Gy*s.yz() + Gx*s.xz())*w;
+		}
+	}
+
+	//! Add the geometrical stiffness of an integration point to ke
+	static void geometricalStiffness(int neln, const vec3d* G, const mat3ds& s, double w, matrix& ke)
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+		for (int i = 0; i<N; ++i)
+		{
+			double* ke0 = ke[3*i  ];
+			double* ke1 = ke[3*i+1];
+			double* ke2 = ke[3*i+2];
+			for (int j = 0; j<N; ++j)
+			{
+				double kab = (G[i]*(s * G[j]))*w;
+
+				ke0[3*j  ] += kab;
+				ke1[3*j+1] += kab;
+				ke2[3*j+2] += kab;
+			}
+		}
+	}
+
+	//! Add the material stiffness of an integration point to ke. 
+	//! D is the spatial elasticity tensor in Voigt notation.
+	static void materialStiffness(int neln, const vec3d* G, const double D[6][6], double w, matrix& ke)
+	{
+		const int N = (NEL > 0 ? NEL : neln);
+
+		// The 'D*BL' matrix
+		double DBL[6][3];
+
+		for (int i=0, i3=0; i<N; ++i, i3 += 3)
+		{
+			const double Gxi = G[i].x;
+			const double Gyi = G[i].y;
+			const double Gzi = G[i].z;
+
+			double* ke0 = ke[i3  ];
+			double* ke1 = ke[i3+1];
+			double* ke2 = ke[i3+2];
+
+			for (int j=0, j3 = 0; j<N; ++j, j3 += 3)
+			{
+				const double Gxj = G[j].x;
+				const double Gyj = G[j].y;
+				const double Gzj = G[j].z;
+
+				// calculate D*BL matrices
+				for (int k = 0; k<6; ++k)
+				{
+					DBL[k][0] = (D[k][0]*Gxj+D[k][3]*Gyj+D[k][5]*Gzj);
+					DBL[k][1] = (D[k][1]*Gyj+D[k][3]*Gxj+D[k][4]*Gzj);
+					DBL[k][2] = (D[k][2]*Gzj+D[k][4]*Gyj+D[k][5]*Gxj);
+				}
+
+				ke0[j3  ] += (Gxi*DBL[0][0] + Gyi*DBL[3][0] + Gzi*DBL[5][0] )*w;
+				ke0[j3+1] += (Gxi*DBL[0][1] + Gyi*DBL[3][1] + Gzi*DBL[5][1] )*w;
+				ke0[j3+2] += (Gxi*DBL[0][2] + Gyi*DBL[3][2] + Gzi*DBL[5][2] )*w;
+
+				ke1[j3  ] += (Gyi*DBL[1][0] + Gxi*DBL[3][0] + Gzi*DBL[4][0] )*w;
+				ke1[j3+1] += (Gyi*DBL[1][1] + Gxi*DBL[3][1] + Gzi*DBL[4][1] )*w;
+				ke1[j3+2] += (Gyi*DBL[1][2] + Gxi*DBL[3][2] + Gzi*DBL[4][2] )*w;
+
+				ke2[j3  ] += (Gzi*DBL[2][0] + Gyi*DBL[4][0] + Gxi*DBL[5][0] )*w;
+				ke2[j3+1] += (Gzi*DBL[2][1] + Gyi*DBL[4][1] + Gxi*DBL[5][1] )*w;
+				ke2[j3+2] += (Gzi*DBL[2][2] + Gyi*DBL[4][2] + Gxi*DBL[5][2] )*w;
+			}
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+//! This class selects the fixed-size kernel at runtime. The kernel id is the 
+//! number of nodes of the specialized kernel, or zero for the general kernel
+//! (see FESolidDomain::ElementKernel).
+class FESolidKernel
+{
+public:
+	//! Return the kernel id for elements with neln nodes. The kernels only depend on the 
+	//! number of nodes (not on the integration rule), so e.g. all hex8 variants share a kernel.
+	//! Kernels are provided for linear and quadratic tets, pentas and hexes.
+	static int Select(int neln)
+	{
+		switch (neln)
+		{
+		case  4:	// tet4
+		case  6:	// penta6
+		case  8:	// hex8
+		case 10:	// tet10
+		case 20:	// hex20
+		case 27:	// hex27
+			return neln;
+		default:
+			return 0;
+		}
+	}
+
+	static double invjac(int kernel, int neln, const vec3d* r, const double* Gr, const double* Gs, const double* Gt, double Ji[3][3])
+	{
+		switch (kernel)
+		{
+		case  4: return FESolidElementKernel< 4>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		case  6: return FESolidElementKernel< 6>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		case  8: return FESolidElementKernel< 8>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		case 10: return FESolidElementKernel<10>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		case 20: return FESolidElementKernel<20>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		case 27: return FESolidElementKernel<27>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		default:
+			return FESolidElementKernel<0>::invjac(neln, r, Gr, Gs, Gt, Ji);
+		}
+	}
+
+	static void shapeGradient(int kernel, int neln, const double Ji[3][3], const double* Gr, const double* Gs, const double* Gt, vec3d* G)
+	{
+		switch (kernel)
+		{
+		case  4: FESolidElementKernel< 4>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		case  6: FESolidElementKernel< 6>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		case  8: FESolidElementKernel< 8>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		case 10: FESolidElementKernel<10>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		case 20: FESolidElementKernel<20>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		case 27: FESolidElementKernel<27>::shapeGradient(neln, Ji, Gr, Gs, Gt, G); break;
+		default:
+			FESolidElementKernel<0>::shapeGradient(neln, Ji, Gr, Gs, Gt, G);
+		}
+	}
+
+	static void defgrad(int kernel, int neln, const mat3d& Ji, const vec3d* r, const double* Gr, const double* Gs, const double* Gt, mat3d& F)
+	{
+		switch (kernel)
+		{
+		case  4: FESolidElementKernel< 4>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		case  6: FESolidElementKernel< 6>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		case  8: FESolidElementKernel< 8>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		case 10: FESolidElementKernel<10>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		case 20: FESolidElementKernel<20>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		case 27: FESolidElementKernel<27>::defgrad(neln, Ji, r, Gr, Gs, Gt, F); break;
+		default:
+			FESolidElementKernel<0>::defgrad(neln, Ji, r, Gr, Gs, Gt, F);
+		}
+	}
+
+	static void internalForce(int kernel, int neln, const vec3d* G, const mat3ds& s, double w, double* fe)
+	{
+		switch (kernel)
+		{
+		case  4: FESolidElementKernel< 4>::internalForce(neln, G, s, w, fe); break;
+		case  6: FESolidElementKernel< 6>::internalForce(neln, G, s, w, fe); break;
+		case  8: FESolidElementKernel< 8>::internalForce(neln, G, s, w, fe); break;
+		case 10: FESolidElementKernel<10>::internalForce(neln, G, s, w, fe); break;
+		case 20: FESolidElementKernel<20>::internalForce(neln, G, s, w, fe); break;
+		case 27: FESolidElementKernel<27>::internalForce(neln, G, s, w, fe); break;
+		default:
+			FESolidElementKernel<0>::internalForce(neln, G, s, w, fe);
+		}
+	}
+
+	static void geometricalStiffness(int kernel, int neln, const vec3d* G, const mat3ds& s, double w, matrix& ke)
+	{
+		switch (kernel)
+		{
+		case  4: FESolidElementKernel< 4>::geometricalStiffness(neln, G, s, w, ke); break;
+		case  6: FESolidElementKernel< 6>::geometricalStiffness(neln, G, s, w, ke); break;
+		case  8: FESolidElementKernel< 8>::geometricalStiffness(neln, G, s, w, ke); break;
+		case 10: FESolidElementKernel<10>::geometricalStiffness(neln, G, s, w, ke); break;
+		case 20: FESolidElementKernel<20>::geometricalStiffness(neln, G, s, w, ke); break;
+		case 27: FESolidElementKernel<27>::geometricalStiffness(neln, G, s, w, ke); break;
+		default:
+			FESolidElementKernel<0>::geometricalStiffness(neln, G, s, w, ke);
+		}
+	}
+
+	static void materialStiffness(int kernel, int neln, const vec3d* G, const double D[6][6], double w, matrix& ke)
+	{
+		switch (kernel)
+		{
+		case  4: FESolidElementKernel< 4>::materialStiffness(neln, G, D, w, ke); break;
+		case  6: FESolidElementKernel< 6>::materialStiffness(neln, G, D, w, ke); break;
+		case  8: FESolidElementKernel< 8>::materialStiffness(neln, G, D, w, ke); break;
+		case 10: FESolidElementKernel<10>::materialStiffness(neln, G, D, w, ke); break;
+		case 20: FESolidElementKernel<20>::materialStiffness(neln, G, D, w, ke); break;
+		case 27: FESolidElementKernel<27>::materialStiffness(neln, G, D, w, ke); break;
+		default:
+			FESolidElementKernel<0>::materialStiffness(neln, G, D, w, ke);
+		}
+	}
+};
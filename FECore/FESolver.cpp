@@ -45,6 +45,8 @@ BEGIN_FECORE_CLASS(FESolver, FECoreBase)
 	ADD_PARAMETER(m_eq_scheme, "equation_scheme");
 	ADD_PARAMETER(m_eq_order , "equation_order" );
 	ADD_PARAMETER(m_bwopt    , "optimize_bw");
+	ADD_PARAMETER(m_bcoloredAssembly, "colored_assembly");
+	ADD_PARAMETER(m_bassemblyMap    , "cache_assembly_map");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -62,6 +64,9 @@ FESolver::FESolver(FEModel* fem) : FECoreBase(fem)
 
 	m_bwopt = 0;
 
+	m_bcoloredAssembly = false;
+	m_bassemblyMap = false;
+
 	m_eq_scheme = EQUATION_SCHEME::STAGGERED;
 	m_eq_order = EQUATION_ORDER::NORMAL_ORDER;
 }
@@ -186,6 +186,8 @@ public: //TODO Move these parameters elsewhere
 	int					m_msymm;		//!< matrix symmetry flag for linear solver allocation
 	int					m_eq_scheme;	//!< equation number scheme (used in InitEquations)
 	int					m_eq_order;		//!< normal or reverse ordering
+	bool				m_bcoloredAssembly;	//!< assemble domain stiffness matrices color by color
+	bool				m_bassemblyMap;		//!< cache element assembly maps of the global matrix
 	int					m_neq;			//!< number of equations
 	std::vector<int>	m_part;			//!< partitions of linear system
 	std::vector<int>	m_dofMap;		//!< array stores for each equation the corresponding dof index
@@ -0,0 +1,141 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FESurfaceBVH.h"
+#include "FESurface.h"
+#include "FEMesh.h"
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// squared distance of a point to a box
+static inline double BoxDistance2(const vec3d& r0, const vec3d& r1, const vec3d& x)
+{
+	double dx = (x.x < r0.x ? r0.x - x.x : (x.x > r1.x ? x.x - r1.x : 0.0));
+	double dy = (x.y < r0.y ? r0.y - x.y : (x.y > r1.y ? x.y - r1.y : 0.0));
+	double dz = (x.z < r0.z ? r0.z - x.z : (x.z > r1.z ? x.z - r1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceBVH::FESurfaceBVH(FESurface* ps) : m_ps(ps)
+{
+}
+
+//-----------------------------------------------------------------------------
+int FESurfaceBVH::Items() const
+{
+	return (m_ps ? m_ps->Elements() : 0);
+}
+
+//-----------------------------------------------------------------------------
+// calculate the bounding box of a facet
+void FESurfaceBVH::ItemBox(int i, vec3d& r0, vec3d& r1) const
+{
+	FESurfaceElement& el = m_ps->Element(i);
+	int ne = el.Nodes();
+	r0 = r1 = m_ps->Node(el.m_lnode[0]).m_rt;
+	for (int j = 1; j < ne; ++j)
+	{
+		vec3d r = m_ps->Node(el.m_lnode[j]).m_rt;
+		if (r.x < r0.x) r0.x = r.x; if (r.x > r1.x) r1.x = r.x;
+		if (r.y < r0.y) r0.y = r.y; if (r.y > r1.y) r1.y = r.y;
+		if (r.z < r0.z) r0.z = r.z; if (r.z > r1.z) r1.z = r.z;
+	}
+}
+
+//-----------------------------------------------------------------------------
+int FESurfaceBVH::FindClosestNode(const vec3d& x, double R, const std::function<bool(int)>& filter) const
+{
+	if (m_node.empty()) return -1;
+
+	// nodes that are farther than this are rejected
+	const double R2 = (R > 0 ? R*R : 0.0);
+
+	int imin = -1;
+	double d2min = 0.0;
+
+	// depth-first traversal, visiting the nearest child first
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+
+		// skip boxes that cannot contain a better candidate (note that ties
+		// must not be pruned since they are resolved by the node index)
+		double db = BoxDistance2(node.r0, node.r1, x);
+		if ((R2 > 0) && (db > R2)) continue;
+		if ((imin >= 0) && (db > d2min)) continue;
+
+		if (node.child >= 0)
+		{
+			const NODE& a = m_node[node.child];
+			const NODE& b = m_node[node.child + 1];
+			double da = BoxDistance2(a.r0, a.r1, x);
+			double dbb = BoxDistance2(b.r0, b.r1, x);
+			if (da <= dbb)
+			{
+				stack[ns++] = node.child + 1;
+				stack[ns++] = node.child;
+			}
+			else
+			{
+				stack[ns++] = node.child;
+				stack[ns++] = node.child + 1;
+			}
+		}
+		else
+		{
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				FESurfaceElement& el = m_ps->Element(m_item[i]);
+				int ne = el.Nodes();
+				for (int j = 0; j < ne; ++j)
+				{
+					int k = el.m_lnode[j];
+					vec3d r = m_ps->Node(k).m_rt;
+					double d2 = (r - x)*(r - x);
+					if ((R2 > 0) && (d2 > R2)) continue;
+
+					if ((imin == -1) || (d2 < d2min) || ((d2 == d2min) && (k < imin)))
+					{
+						if (filter && (filter(k) == false)) continue;
+						imin = k;
+						d2min = d2;
+					}
+				}
+			}
+		}
+	}
+
+	return imin;
+}
@@ -72,6 +72,12 @@ public: // these functions use the actual sparse matrix m_K
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override { m_K->Assemble(ke, lmi, lmj); }
 
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map) override { return (m_K ? m_K->AssemblyMap(nr, nc, lmi, lmj, map) : false); }
+
+	//! assemble a matrix using a precomputed assembly map
+	void AssembleMapped(const matrix& ke, const std::vector<int>& map) override { m_K->AssembleMapped(ke, map); }
+
 	//! check if an entry was allocated
 	bool check(int i, int j) override { return m_K->check(i, j); }
 
@@ -90,6 +96,9 @@ public: // these functions use the actual sparse matrix m_K
 	//! release memory for storing data
 	void Clear() override { m_K->Clear(); }
 
+	//! turn atomic assembly on or off
+	void SetAtomicAssembly(bool b) override { SparseMatrix::SetAtomicAssembly(b); if (m_K) m_K->SetAtomicAssembly(b); }
+
 	// interface to compact matrices
 	double* Values() override { return m_K->Values(); }
 	int*    Indices() override { return m_K->Indices(); }
@@ -29,12 +29,59 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "MatrixProfile.h"
 #include <assert.h>
+#include <algorithm>
 
 SparseMatrixProfile::ColumnProfile::ColumnProfile(const SparseMatrixProfile::ColumnProfile& a)
 {
 	m_data = a.m_data;
 }
 
+bool SparseMatrixProfile::ColumnProfile::operator == (const SparseMatrixProfile::ColumnProfile& a) const
+{
+	// Note that insertRow always merges adjacent intervals, so identical 
+	// columns are stored identically.
+	if (m_data.size() != a.m_data.size()) return false;
+	for (size_t i = 0; i < m_data.size(); ++i)
+	{
+		if ((m_data[i].start != a.m_data[i].start) || (m_data[i].end != a.m_data[i].end)) return false;
+	}
+	return true;
+}
+
+void SparseMatrixProfile::ColumnProfile::insertRows(const int* rows, int n)
+{
+	if (n == 0) return;
+
+	// merge the intervals of this column with the intervals formed by the rows.
+	// Both are sorted, so this can be done in one pass. Overlapping or adjacent 
+	// intervals are combined, so the result is the same as calling insertRow for each row.
+	vector<RowEntry> data;
+	data.reserve(m_data.size() + n);
+
+	int N = (int)m_data.size();
+	int i = 0, j = 0;
+	while ((i < N) || (j < n))
+	{
+		// get the next interval
+		RowEntry re;
+		if ((j >= n) || ((i < N) && (m_data[i].start <= rows[j])))
+		{
+			re = m_data[i++];
+		}
+		else
+		{
+			re.start = re.end = rows[j++];
+			while ((j < n) && (rows[j] == re.end + 1)) re.end = rows[j++];
+		}
+
+		// add it to the new list
+		if (data.empty() || (re.start > data.back().end + 1)) data.push_back(re);
+		else if (re.end > data.back().end) data.back().end = re.end;
+	}
+
+	m_data.swap(data);
+}
+
 void SparseMatrixProfile::ColumnProfile::insertRow(int row)
 {
 	// first, check if empty
@@ -204,6 +251,18 @@ SparseMatrixProfile& SparseMatrixProfile::operator =(const SparseMatrixProfile&
 	return (*this);
 }
 
+//-----------------------------------------------------------------------------
+//! Compares two profiles.
+bool SparseMatrixProfile::operator == (const SparseMatrixProfile& mp) const
+{
+	if ((m_nrow != mp.m_nrow) || (m_ncol != mp.m_ncol)) return false;
+	for (size_t i = 0; i < m_prof.size(); ++i)
+	{
+		if ((m_prof[i] == mp.m_prof[i]) == false) return false;
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Create the profile of a diagonal matrix
 void SparseMatrixProfile::CreateDiagonal()
@@ -245,6 +304,7 @@ void SparseMatrixProfile::UpdateProfile(vector< vector<int> >& LM, int M)
 
 	// fill the valence array
 	int Ntot = 0;
+#pragma omp parallel for reduction(+:Ntot)
 	for (int i = 0; i<M; ++i)
 	{
 		int* lm = &(LM[i])[0];
@@ -252,7 +312,11 @@ void SparseMatrixProfile::UpdateProfile(vector< vector<int> >& LM, int M)
 		Ntot += N;
 		for (int j = 0; j<N; ++j)
 		{
-			if (lm[j] >= 0) pval[lm[j]]++;
+			if (lm[j] >= 0)
+			{
+#pragma omp atomic
+				pval[lm[j]]++;
+			}
 		}
 	}
 
@@ -284,27 +348,39 @@ void SparseMatrixProfile::UpdateProfile(vector< vector<int> >& LM, int M)
 	for (int i = 1; i<nc; ++i) ppelc[i] = ppelc[i - 1] + pval[i - 1];
 
 	// loop over all columns
-#pragma omp parallel for schedule(dynamic)
-	for (int i = 0; i<nc; ++i)
+	// For each column we collect the rows of all the elements that contribute to it,
+	// sort them and then merge them in one go into the column profile.
+#pragma omp parallel
 	{
-		if (pval[i] > 0)
-		{
-			// get the column
-			ColumnProfile& a = m_prof[i];
+		vector<int> rows;
 
-			// loop over all elements in the plec
-			for (int j = 0; j<pval[i]; ++j)
+#pragma omp for schedule(dynamic, 64)
+		for (int i = 0; i<nc; ++i)
+		{
+			if (pval[i] > 0)
 			{
-				int iel = (ppelc[i])[j];
-				int* lm = &(LM[iel])[0];
-				int N = (int)LM[iel].size();
-				for (int k = 0; k<N; ++k)
+				// get the column
+				ColumnProfile& a = m_prof[i];
+
+				// loop over all elements in the plec
+				rows.clear();
+				for (int j = 0; j<pval[i]; ++j)
 				{
-					if (lm[k] >= 0)
-					{ 
-						a.insertRow(lm[k]);
+					int iel = (ppelc[i])[j];
+					int* lm = &(LM[iel])[0];
+					int N = (int)LM[iel].size();
+					for (int k = 0; k<N; ++k)
+					{
+						if (lm[k] >= 0) rows.push_back(lm[k]);
 					}
 				}
+
+				// remove duplicates
+				std::sort(rows.begin(), rows.end());
+				rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+				// add them to the column profile
+				a.insertRows(&rows[0], (int)rows.size());
 			}
 		}
 	}
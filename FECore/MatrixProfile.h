@@ -85,6 +85,13 @@ public:
 		// add row index to column profile
 		void insertRow(int row);
 
+		// add a list of row indices to the column profile.
+		// The rows must be sorted in ascending order and cannot contain duplicates.
+		void insertRows(const int* rows, int n);
+
+		// see if two column profiles are identical
+		bool operator == (const ColumnProfile& a) const;
+
 	private:
 		vector<RowEntry>	m_data;	// the column profile data
 	};
@@ -102,6 +109,9 @@ public:
 	//! assignment operator
 	SparseMatrixProfile& operator = (const SparseMatrixProfile& mp);
 
+	//! see if two profiles are identical
+	bool operator == (const SparseMatrixProfile& mp) const;
+
 	//! Create the profile of a diagonal matrix
 	void CreateDiagonal();
 
@@ -35,6 +35,7 @@ SparseMatrix::SparseMatrix()
 {
 	m_nrow = m_ncol = 0;
 	m_nsize = 0;
+	m_batomic = true;
 }
 
 SparseMatrix::~SparseMatrix()
@@ -52,3 +53,32 @@ void SparseMatrix::scale(const vector<double>& L, const vector<double>& R)
 {
 	assert(false);
 }
+
+//! assemble a matrix using a precomputed assembly map
+//! This default implementation scatters directly into the values array.
+void SparseMatrix::AssembleMapped(const matrix& ke, const std::vector<int>& map)
+{
+	double* pv = Values();
+	assert(pv);
+
+	const int N = ke.rows();
+	const int M = ke.columns();
+	const int* pm = &map[0];
+	for (int i = 0; i < N; ++i, pm += M)
+	{
+		const double* ki = ke[i];
+		for (int j = 0; j < M; ++j)
+		{
+			int n = pm[j];
+			if (n >= 0)
+			{
+				if (m_batomic)
+				{
+					#pragma omp atomic
+					pv[n] += ki[j];
+				}
+				else pv[n] += ki[j];
+			}
+		}
+	}
+}
@@ -60,6 +60,13 @@ public:
 	//! return number of nonzeros
 	int NonZeroes() const { return m_nsize; }
 
+	//! Turn atomic updates in the assembly functions on or off. This should only be turned
+	//! off when the caller guarantees that concurrent assembly calls never touch the same entries.
+	virtual void SetAtomicAssembly(bool b) { m_batomic = b; }
+
+	//! see if atomic updates are used during assembly
+	bool AtomicAssembly() const { return m_batomic; }
+
 public: // functions to be overwritten in derived classes
 
 	//! set all matrix elements to zero
@@ -74,6 +81,14 @@ public: // functions to be overwritten in derived classes
 	//! assemble a matrix into the sparse matrix
 	virtual void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) = 0;
 
+	//! Calculate the assembly map of an element matrix. For each entry (i,j) of an nr x nc element 
+	//! matrix, map[i*nc + j] stores the offset into the values array, or -1 if the entry is not assembled.
+	//! Returns false if the matrix format does not support assembly maps.
+	virtual bool AssemblyMap(int nr, int nc, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map) { return false; }
+
+	//! assemble a matrix using a precomputed assembly map (see AssemblyMap)
+	virtual void AssembleMapped(const matrix& ke, const std::vector<int>& map);
+
 	//! check if an entry was allocated
 	virtual bool check(int i, int j) = 0;
 
@@ -111,4 +126,5 @@ protected:
 	// NOTE: These values are set by derived classes
 	int	m_nrow, m_ncol;		//!< dimension of matrix
 	int	m_nsize;			//!< number of nonzeroes (i.e. matrix elements actually allocated)
+	bool	m_batomic;		//!< use atomic updates during assembly (default = true)
 };
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "mortar.h"
 #include <math.h>
 #include "FEMesh.h"
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 // subtract operator for POINT2D
@@ -541,29 +542,232 @@ bool CalculateMortarIntersection(FESurface& ss, FESurface& ms, int k, int l, Pat
 	return (patch.Empty() == false);
 }
 
+//-----------------------------------------------------------------------------
+// Axis-aligned bounding box of a surface facet.
+struct FACET_BOX
+{
+	vec3d	r0, r1;
+
+	void inflate(double d)
+	{
+		r0.x -= d; r0.y -= d; r0.z -= d;
+		r1.x += d; r1.y += d; r1.z += d;
+	}
+
+	void add(const vec3d& r)
+	{
+		if (r.x < r0.x) r0.x = r.x;
+		if (r.y < r0.y) r0.y = r.y;
+		if (r.z < r0.z) r0.z = r.z;
+		if (r.x > r1.x) r1.x = r.x;
+		if (r.y > r1.y) r1.y = r.y;
+		if (r.z > r1.z) r1.z = r.z;
+	}
+
+	double radius() const
+	{
+		vec3d d = r1 - r0;
+		return (d.x > d.y ? (d.x > d.z ? d.x : d.z) : (d.y > d.z ? d.y : d.z));
+	}
+
+	bool intersects(const FACET_BOX& b) const
+	{
+		return ((r0.x <= b.r1.x) && (b.r0.x <= r1.x) &&
+				(r0.y <= b.r1.y) && (b.r0.y <= r1.y) &&
+				(r0.z <= b.r1.z) && (b.r0.z <= r1.z));
+	}
+};
+
+//-----------------------------------------------------------------------------
+// calculate the bounding box of a surface facet
+static FACET_BOX FacetBox(FESurface& s, FESurfaceElement& el)
+{
+	FACET_BOX b;
+	b.r0 = b.r1 = s.Node(el.m_lnode[0]).m_rt;
+	int n = el.Nodes();
+	for (int i=1; i<n; ++i) b.add(s.Node(el.m_lnode[i]).m_rt);
+	return b;
+}
+
+//-----------------------------------------------------------------------------
+// Uniform bucket grid over the facets of a surface. This is used to find the
+// mortar facets that can possibly intersect a non-mortar facet without having
+// to test all facet pairs.
+class FacetGrid
+{
+public:
+	void Build(const vector<FACET_BOX>& box)
+	{
+		m_box = box;
+		int N = (int) box.size();
+		if (N == 0) return;
+
+		// bounding box of all facets and average facet size
+		FACET_BOX all = box[0];
+		double h = 0.0;
+		for (int i=0; i<N; ++i)
+		{
+			all.add(box[i].r0);
+			all.add(box[i].r1);
+			h += box[i].radius();
+		}
+		h /= (double) N;
+		double L = all.radius();
+		if (h <= 0.0) h = (L > 0.0 ? L : 1.0);
+		m_r0 = all.r0;
+		vec3d D = all.r1 - all.r0;
+
+		// choose the cell size to be the average facet size, but limit the 
+		// number of cells to a few per facet
+		const int MAX_DIV = 256;
+		m_h = h;
+		for (;;)
+		{
+			m_n[0] = (int)(D.x / m_h) + 1;
+			m_n[1] = (int)(D.y / m_h) + 1;
+			m_n[2] = (int)(D.z / m_h) + 1;
+			double ncells = (double) m_n[0] * (double) m_n[1] * (double) m_n[2];
+			if ((ncells <= 4.0*N) && (m_n[0] <= MAX_DIV) && (m_n[1] <= MAX_DIV) && (m_n[2] <= MAX_DIV)) break;
+			m_h *= 2.0;
+		}
+
+		// count the facets in each cell
+		int NC = m_n[0] * m_n[1] * m_n[2];
+		m_off.assign(NC + 1, 0);
+		for (int i=0; i<N; ++i)
+		{
+			int c0[3], c1[3];
+			CellRange(box[i], c0, c1);
+			for (int k=c0[2]; k<=c1[2]; ++k)
+				for (int j=c0[1]; j<=c1[1]; ++j)
+					for (int l=c0[0]; l<=c1[0]; ++l) m_off[Cell(l, j, k) + 1]++;
+		}
+		for (int i=0; i<NC; ++i) m_off[i+1] += m_off[i];
+
+		// fill the cells
+		m_facet.resize(m_off[NC]);
+		vector<int> pos(m_off.begin(), m_off.end() - 1);
+		for (int i=0; i<N; ++i)
+		{
+			int c0[3], c1[3];
+			CellRange(box[i], c0, c1);
+			for (int k=c0[2]; k<=c1[2]; ++k)
+				for (int j=c0[1]; j<=c1[1]; ++j)
+					for (int l=c0[0]; l<=c1[0]; ++l) m_facet[pos[Cell(l, j, k)]++] = i;
+		}
+	}
+
+	// Find all facets whose bounding box intersects b. The facets are returned 
+	// in ascending order. The tag array must be of size Facets() and initialized
+	// to -1; tag value id must be unique per query. 
+	void FindCandidates(const FACET_BOX& b, int id, vector<int>& tag, vector<int>& list) const
+	{
+		list.clear();
+		if (m_box.empty()) return;
+
+		int c0[3], c1[3];
+		CellRange(b, c0, c1);
+		for (int k=c0[2]; k<=c1[2]; ++k)
+			for (int j=c0[1]; j<=c1[1]; ++j)
+				for (int l=c0[0]; l<=c1[0]; ++l)
+				{
+					int c = Cell(l, j, k);
+					for (int n = m_off[c]; n<m_off[c+1]; ++n)
+					{
+						int m = m_facet[n];
+						if ((tag[m] != id) && m_box[m].intersects(b))
+						{
+							tag[m] = id;
+							list.push_back(m);
+						}
+					}
+				}
+		sort(list.begin(), list.end());
+	}
+
+	int Facets() const { return (int) m_box.size(); }
+
+private:
+	int Cell(int i, int j, int k) const { return (k*m_n[1] + j)*m_n[0] + i; }
+
+	int Clamp(double x, int n) const
+	{
+		int i = (int) floor(x / m_h);
+		if (i < 0) return 0;
+		if (i >= n) return n - 1;
+		return i;
+	}
+
+	void CellRange(const FACET_BOX& b, int c0[3], int c1[3]) const
+	{
+		c0[0] = Clamp(b.r0.x - m_r0.x, m_n[0]); c1[0] = Clamp(b.r1.x - m_r0.x, m_n[0]);
+		c0[1] = Clamp(b.r0.y - m_r0.y, m_n[1]); c1[1] = Clamp(b.r1.y - m_r0.y, m_n[1]);
+		c0[2] = Clamp(b.r0.z - m_r0.z, m_n[2]); c1[2] = Clamp(b.r1.z - m_r0.z, m_n[2]);
+	}
+
+private:
+	vector<FACET_BOX>	m_box;		//!< facet bounding boxes
+	vec3d				m_r0;		//!< grid origin
+	double				m_h;		//!< cell size
+	int					m_n[3];		//!< number of cells in each direction
+	vector<int>			m_off;		//!< offset into facet list for each cell
+	vector<int>			m_facet;	//!< facet list
+};
+
+//-----------------------------------------------------------------------------
+// Calculates the mortar surface. Only the facet pairs whose bounding boxes
+// overlap are intersected. The non-mortar facet boxes are inflated by their 
+// own size so that facet pairs that are separated by a (small) gap are 
+// still found. Only non-empty patches are added to the mortar surface.
+// NOTE: Previously, all facet pairs were intersected, regardless of the 
+// distance between them. Now, facet pairs that are separated by a gap that
+// is larger than the size of the non-mortar facet are no longer found, and 
+// do not contribute to the mortar weights.
 void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& mortar)
 {
-	// loop over all non-mortar facets
 	int NSF = ss.Elements();
 	int NMF = ms.Elements();
-	for (int i=0; i<NSF; ++i)
+
+	// build the search grid for the mortar facets
+	vector<FACET_BOX> mbox(NMF);
+	for (int j=0; j<NMF; ++j) mbox[j] = FacetBox(ms, ms.Element(j));
+	FacetGrid grid;
+	grid.Build(mbox);
+
+	// calculate the patches of each non-mortar facet
+	vector< vector<Patch> > patches(NSF);
+#pragma omp parallel
 	{
-		// get the non-mortar surface element
-		FESurfaceElement& se = ss.Element(i);
+		vector<int> tag(NMF, -1);
+		vector<int> candidates;
 
-		// loop over all the mortar surface elements
-		for (int j=0; j<NMF; ++j)
+#pragma omp for schedule(dynamic, 16)
+		for (int i=0; i<NSF; ++i)
 		{
-			// get the next surface element
-			FESurfaceElement& me = ms.Element(j);
-
-			// calculate the patch of triangles, representing the intersection
-			// of the non-mortar facet with the mortar facet
-			Patch patch(i,j);
-			CalculateMortarIntersection(ss, ms, i, j, patch);
-			mortar.AddPatch(patch);
+			// get the (inflated) bounding box of the non-mortar facet
+			FACET_BOX b = FacetBox(ss, ss.Element(i));
+			b.inflate(b.radius());
+
+			// loop over all candidate mortar facets
+			grid.FindCandidates(b, i, tag, candidates);
+			for (size_t n=0; n<candidates.size(); ++n)
+			{
+				int j = candidates[n];
+
+				// calculate the patch of triangles, representing the intersection
+				// of the non-mortar facet with the mortar facet
+				Patch patch(i, j);
+				if (CalculateMortarIntersection(ss, ms, i, j, patch)) patches[i].push_back(patch);
+			}
 		}
 	}
+
+	// collect all the patches
+	for (int i=0; i<NSF; ++i)
+	{
+		vector<Patch>& pi = patches[i];
+		for (size_t n=0; n<pi.size(); ++n) mortar.AddPatch(pi[n]);
+	}
 }
 
 bool ExportMortar(MortarSurface& mortar, const char* szfile)
@@ -132,7 +132,8 @@ private:
 FECORE_API bool CalculateMortarIntersection(FESurface& ss, FESurface& ms, int k, int l, Patch& patch);
 
 //-----------------------------------------------------------------------------
-// Calculates the mortar intersection between two surfaces
+// Calculates the mortar intersection between two surfaces. Only facets that
+// are within a distance of the non-mortar facet size are considered.
 FECORE_API void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& s);
 
 //-----------------------------------------------------------------------------
@@ -99,6 +99,59 @@ void vsub(vector<double>& a, const vector<double>& l, const vector<double>& r)
 	for (size_t i=0; i<a.size(); ++i) a[i] = l[i] - r[i];
 }
 
+// Vectors shorter than this are processed on a single thread
+#define VFUSED_MIN_PARALLEL	20000
+
+// These kernels apply one quasi-Newton update and compute the dot product needed 
+// for the next one in the same pass, so the vector is only streamed once per update.
+double vadds_dot(double* y, const double* x, double a, const double* z, int n)
+{
+	double s = 0.0;
+	if (x == nullptr)
+	{
+		if (z == nullptr) return 0.0;
+#pragma omp parallel for reduction(+:s) schedule(static) if (n > VFUSED_MIN_PARALLEL)
+		for (int i = 0; i < n; ++i) s += z[i] * y[i];
+	}
+	else if (z == nullptr)
+	{
+#pragma omp parallel for schedule(static) if (n > VFUSED_MIN_PARALLEL)
+		for (int i = 0; i < n; ++i) y[i] += x[i] * a;
+	}
+	else
+	{
+#pragma omp parallel for reduction(+:s) schedule(static) if (n > VFUSED_MIN_PARALLEL)
+		for (int i = 0; i < n; ++i)
+		{
+			y[i] += x[i] * a;
+			s += z[i] * y[i];
+		}
+	}
+	return s;
+}
+
+double vaddsub_dot(double* y, const double* x1, const double* x2, double a, const double* z, int n)
+{
+	if ((x1 == nullptr) || (x2 == nullptr)) return vadds_dot(y, nullptr, a, z, n);
+
+	double s = 0.0;
+	if (z == nullptr)
+	{
+#pragma omp parallel for schedule(static) if (n > VFUSED_MIN_PARALLEL)
+		for (int i = 0; i < n; ++i) y[i] += a * (x1[i] - x2[i]);
+	}
+	else
+	{
+#pragma omp parallel for reduction(+:s) schedule(static) if (n > VFUSED_MIN_PARALLEL)
+		for (int i = 0; i < n; ++i)
+		{
+			y[i] += a * (x1[i] - x2[i]);
+			s += z[i] * y[i];
+		}
+	}
+	return s;
+}
+
 vector<double> operator + (const vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
@@ -63,6 +63,13 @@ void FECORE_API vsub(vector<double>& a, const vector<double>& l, const vector<do
 // scale each component of a vector
 void FECORE_API vscale(vector<double>& a, const vector<double>& s);
 
+// fused update and dot product: y += a*x, returns z*y using the updated y.
+// If x is null, y is not updated; if z is null, the dot product is skipped.
+double FECORE_API vadds_dot(double* y, const double* x, double a, const double* z, int n);
+
+// same as vadds_dot, but adds the scaled difference of two vectors: y += a*(x1 - x2)
+double FECORE_API vaddsub_dot(double* y, const double* x1, const double* x2, double a, const double* z, int n);
+
 // gather operation (copy mesh data to vector)
 void FECORE_API gather(vector<double>& v, FEMesh& mesh, int ndof);
 void FECORE_API gather(vector<double>& v, FEMesh& mesh, const vector<int>& dof);
@@ -0,0 +1,664 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "AMG_Preconditioner.h"
+#include "CompactSymmMatrix.h"
+#include "CompactUnSymmMatrix.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/log.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// The coarsest level is solved with a dense LU factorization, which needs N^2 storage. 
+// This can only be done if the coarsest level has at most this many equations (or 
+// max_coarse_size, if that is larger). Larger coarse levels are only smoothed.
+#define AMG_MAX_DENSE_COARSE	2000
+
+// number of smoothing iterations on the coarsest level when it is too large for the LU solve
+#define AMG_COARSE_SMOOTH_ITERS	10
+
+BEGIN_FECORE_CLASS(AMG_Preconditioner, Preconditioner)
+	ADD_PARAMETER(m_maxLevels   , "max_levels");
+	ADD_PARAMETER(m_maxCoarse   , "max_coarse_size");
+	ADD_PARAMETER(m_theta       , "strength_threshold");
+	ADD_PARAMETER(m_nsmooth     , "smooth_iters");
+	ADD_PARAMETER(m_jacobiWeight, "jacobi_weight");
+	ADD_PARAMETER(m_blockSize   , "block_size");
+END_FECORE_CLASS();
+
+//=================================================================================================
+// y = A*x
+void AMG_Preconditioner::CSRMatrix::mult(const double* x, double* y) const
+{
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < rows; ++i)
+	{
+		double yi = 0.0;
+		for (int k = p[i]; k < p[i + 1]; ++k) yi += v[k] * x[c[k]];
+		y[i] = yi;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// C = A*B
+void AMG_Preconditioner::multiply(const CSRMatrix& A, const CSRMatrix& B, CSRMatrix& C)
+{
+	C.rows = A.rows;
+	C.cols = B.cols;
+	C.p.assign(A.rows + 1, 0);
+
+	// count the nonzeroes of each row
+#pragma omp parallel
+	{
+		vector<int> mark(B.cols, -1);
+#pragma omp for schedule(static)
+		for (int i = 0; i < A.rows; ++i)
+		{
+			int nnz = 0;
+			for (int ka = A.p[i]; ka < A.p[i + 1]; ++ka)
+			{
+				int k = A.c[ka];
+				for (int kb = B.p[k]; kb < B.p[k + 1]; ++kb)
+				{
+					int j = B.c[kb];
+					if (mark[j] != i) { mark[j] = i; nnz++; }
+				}
+			}
+			C.p[i + 1] = nnz;
+		}
+	}
+	for (int i = 0; i < A.rows; ++i) C.p[i + 1] += C.p[i];
+	C.c.resize(C.p[A.rows]);
+	C.v.resize(C.p[A.rows]);
+
+	// calculate the values
+#pragma omp parallel
+	{
+		vector<int> pos(B.cols, -1);
+#pragma omp for schedule(static)
+		for (int i = 0; i < A.rows; ++i)
+		{
+			int n0 = C.p[i];
+			int nnz = n0;
+			for (int ka = A.p[i]; ka < A.p[i + 1]; ++ka)
+			{
+				int k = A.c[ka];
+				double aik = A.v[ka];
+				for (int kb = B.p[k]; kb < B.p[k + 1]; ++kb)
+				{
+					int j = B.c[kb];
+					if ((pos[j] < n0) || (pos[j] >= nnz) || (C.c[pos[j]] != j))
+					{
+						pos[j] = nnz;
+						C.c[nnz] = j;
+						C.v[nnz] = aik * B.v[kb];
+						nnz++;
+					}
+					else C.v[pos[j]] += aik * B.v[kb];
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void AMG_Preconditioner::transpose(const CSRMatrix& A, CSRMatrix& At)
+{
+	At.rows = A.cols;
+	At.cols = A.rows;
+	At.p.assign(A.cols + 1, 0);
+	for (size_t k = 0; k < A.c.size(); ++k) At.p[A.c[k] + 1]++;
+	for (int i = 0; i < A.cols; ++i) At.p[i + 1] += At.p[i];
+	At.c.resize(A.c.size());
+	At.v.resize(A.v.size());
+	vector<int> pos(At.p.begin(), At.p.end() - 1);
+	for (int i = 0; i < A.rows; ++i)
+	{
+		for (int k = A.p[i]; k < A.p[i + 1]; ++k)
+		{
+			int q = pos[A.c[k]]++;
+			At.c[q] = i;
+			At.v[q] = A.v[k];
+		}
+	}
+}
+
+//=================================================================================================
+AMG_Preconditioner::AMG_Preconditioner(FEModel* fem) : Preconditioner(fem)
+{
+	m_maxLevels = 10;
+	m_maxCoarse = 500;
+	m_theta = 0.08;
+	m_nsmooth = 2;
+	m_jacobiWeight = 0.6;
+	m_blockSize = 0;
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* AMG_Preconditioner::CreateSparseMatrix(Matrix_Type ntype)
+{
+	SparseMatrix* K = nullptr;
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : K = new CompactSymmMatrix(1); break;
+	case REAL_UNSYMMETRIC   : K = new CRSSparseMatrix(1); break;
+	case REAL_SYMM_STRUCTURE: K = new CRSSparseMatrix(1); break;
+	}
+	SetSparseMatrix(K);
+	return K;
+}
+
+//-----------------------------------------------------------------------------
+// copy the matrix to a (full) zero-based CSR matrix
+bool AMG_Preconditioner::BuildFineMatrix(CSRMatrix& A)
+{
+	CompactMatrix* K = dynamic_cast<CompactMatrix*>(GetSparseMatrix());
+	if ((K == nullptr) || (K->Rows() != K->Columns())) return false;
+
+	const int N = K->Rows();
+	const int off = K->Offset();
+	const int* pp = K->Pointers();
+	const int* pi = K->Indices();
+	const double* pv = K->Values();
+
+	A.rows = A.cols = N;
+	A.p.assign(N + 1, 0);
+	if (dynamic_cast<CompactSymmMatrix*>(K))
+	{
+		// only the lower triangular part is stored (column by column)
+		for (int j = 0; j < N; ++j)
+			for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+			{
+				int i = pi[k] - off;
+				A.p[i + 1]++;
+				if (i != j) A.p[j + 1]++;
+			}
+		for (int i = 0; i < N; ++i) A.p[i + 1] += A.p[i];
+		A.c.resize(A.p[N]);
+		A.v.resize(A.p[N]);
+		vector<int> pos(A.p.begin(), A.p.end() - 1);
+		for (int j = 0; j < N; ++j)
+			for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+			{
+				int i = pi[k] - off;
+				A.c[pos[i]] = j; A.v[pos[i]++] = pv[k];
+				if (i != j) { A.c[pos[j]] = i; A.v[pos[j]++] = pv[k]; }
+			}
+	}
+	else if (K->isRowBased())
+	{
+		for (int i = 0; i <= N; ++i) A.p[i] = pp[i] - off;
+		A.c.resize(A.p[N]);
+		A.v.assign(pv, pv + A.p[N]);
+		for (int k = 0; k < A.p[N]; ++k) A.c[k] = pi[k] - off;
+	}
+	else
+	{
+		// compressed column storage, so we need the transpose
+		CSRMatrix At;
+		At.rows = At.cols = N;
+		At.p.resize(N + 1);
+		for (int i = 0; i <= N; ++i) At.p[i] = pp[i] - off;
+		At.c.resize(At.p[N]);
+		At.v.assign(pv, pv + At.p[N]);
+		for (int k = 0; k < At.p[N]; ++k) At.c[k] = pi[k] - off;
+		transpose(At, A);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Group the equations of the fine level in blocks. By default, all the 
+// equations of a node form a block.
+void AMG_Preconditioner::BuildBlocks(Level& L)
+{
+	const int N = L.A.rows;
+	L.block.assign(N, -1);
+	L.comp.assign(N, 0);
+	L.nblocks = 0;
+
+	FEModel* fem = GetFEModel();
+	if ((m_blockSize <= 0) && fem)
+	{
+		FEMesh& mesh = fem->GetMesh();
+		for (int i = 0; i < mesh.Nodes(); ++i)
+		{
+			FENode& node = mesh.Node(i);
+			bool bused = false;
+			for (int j = 0; j < node.dofs(); ++j)
+			{
+				int eq = node.m_ID[j];
+				if ((eq >= 0) && (eq < N) && (L.block[eq] == -1))
+				{
+					L.block[eq] = L.nblocks;
+					L.comp[eq] = j;
+					bused = true;
+				}
+			}
+			if (bused) L.nblocks++;
+		}
+
+		// remaining equations (e.g. rigid body or Lagrange multiplier equations) are blocks of their own
+		for (int i = 0; i < N; ++i)
+		{
+			if (L.block[i] == -1) L.block[i] = L.nblocks++;
+		}
+	}
+	else
+	{
+		int bs = (m_blockSize > 0 ? m_blockSize : 1);
+		for (int i = 0; i < N; ++i)
+		{
+			L.block[i] = i / bs;
+			L.comp[i] = i % bs;
+		}
+		L.nblocks = (N + bs - 1) / bs;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Build the multigrid hierarchy
+bool AMG_Preconditioner::Factor()
+{
+	m_level.clear();
+	m_level.push_back(Level());
+	Level& L0 = m_level[0];
+	if (BuildFineMatrix(L0.A) == false) return false;
+	BuildBlocks(L0);
+
+	for (int l = 0; l < m_maxLevels - 1; ++l)
+	{
+		if (m_level[l].A.rows <= m_maxCoarse) break;
+		if (Coarsen(l) == false) break;
+	}
+
+	// setup the smoothers
+	for (size_t l = 0; l < m_level.size(); ++l)
+	{
+		Level& L = m_level[l];
+		const int N = L.A.rows;
+		L.Dinv.assign(N, 0.0);
+		for (int i = 0; i < N; ++i)
+		{
+			for (int k = L.A.p[i]; k < L.A.p[i + 1]; ++k)
+				if ((L.A.c[k] == i) && (L.A.v[k] != 0.0)) L.Dinv[i] = 1.0 / L.A.v[k];
+		}
+		L.x.resize(N);
+		L.b.resize(N);
+		L.r.resize(N);
+	}
+
+	return FactorCoarse();
+}
+
+//-----------------------------------------------------------------------------
+// Create the next level by coarsening level l. Returns false if the matrix 
+// could not be coarsened any further.
+bool AMG_Preconditioner::Coarsen(int l)
+{
+	const CSRMatrix& A = m_level[l].A;
+	const vector<int>& block = m_level[l].block;
+	const vector<int>& comp = m_level[l].comp;
+	const int N = A.rows;
+	const int NB = m_level[l].nblocks;
+
+	// the equations of each block
+	vector<int> bp(NB + 1, 0), beq(N);
+	for (int i = 0; i < N; ++i) bp[block[i] + 1]++;
+	for (int i = 0; i < NB; ++i) bp[i + 1] += bp[i];
+	vector<int> pos(bp.begin(), bp.end() - 1);
+	for (int i = 0; i < N; ++i) beq[pos[block[i]]++] = i;
+
+	// block norms (squared Frobenius norm)
+	vector<double> dnorm(NB, 0.0);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = A.p[i]; k < A.p[i + 1]; ++k)
+			if (block[A.c[k]] == block[i]) dnorm[block[i]] += A.v[k] * A.v[k];
+	}
+
+	// find the strong connections between blocks: |A_IJ| >= theta*sqrt(|A_II|*|A_JJ|)
+	double theta = m_theta * pow(0.5, l);
+	double theta2 = theta*theta;
+	vector<int> Sp(NB + 1, 0), Sj;
+	{
+		vector<double> s(NB, 0.0);
+		vector<int> mark(NB, -1), nbr;
+		for (int I = 0; I < NB; ++I)
+		{
+			nbr.clear();
+			for (int n = bp[I]; n < bp[I + 1]; ++n)
+			{
+				int i = beq[n];
+				for (int k = A.p[i]; k < A.p[i + 1]; ++k)
+				{
+					int J = block[A.c[k]];
+					if (J == I) continue;
+					if (mark[J] != I) { mark[J] = I; s[J] = 0.0; nbr.push_back(J); }
+					s[J] += A.v[k] * A.v[k];
+				}
+			}
+			for (size_t n = 0; n < nbr.size(); ++n)
+			{
+				int J = nbr[n];
+				if (s[J] * s[J] >= theta2*theta2*dnorm[I] * dnorm[J]) Sj.push_back(J);
+			}
+			Sp[I + 1] = (int)Sj.size();
+		}
+	}
+
+	// aggregation
+	vector<int> agg(NB, -1);
+	int nagg = 0;
+
+	// phase 1: blocks whose neighbors are all free form a new aggregate
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg[I] != -1) continue;
+		bool bfree = true;
+		for (int k = Sp[I]; k < Sp[I + 1]; ++k) if (agg[Sj[k]] != -1) { bfree = false; break; }
+		if (bfree)
+		{
+			agg[I] = nagg;
+			for (int k = Sp[I]; k < Sp[I + 1]; ++k) agg[Sj[k]] = nagg;
+			nagg++;
+		}
+	}
+
+	// phase 2: add remaining blocks to a neighboring aggregate
+	vector<int> agg1(agg);
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg[I] != -1) continue;
+		for (int k = Sp[I]; k < Sp[I + 1]; ++k)
+		{
+			if (agg1[Sj[k]] != -1) { agg[I] = agg1[Sj[k]]; break; }
+		}
+	}
+
+	// phase 3: the blocks that are left form new aggregates with their free neighbors
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg[I] != -1) continue;
+		agg[I] = nagg;
+		for (int k = Sp[I]; k < Sp[I + 1]; ++k) if (agg[Sj[k]] == -1) agg[Sj[k]] = nagg;
+		nagg++;
+	}
+
+	// the tentative prolongator has one coarse equation for each component of an aggregate
+	int maxComp = 0;
+	for (int i = 0; i < N; ++i) if (comp[i] + 1 > maxComp) maxComp = comp[i] + 1;
+	vector<int> col((size_t)nagg*maxComp, -1);
+	vector<int> Tc(N);
+	vector<int> cblock, ccomp;
+	int NC = 0;
+	for (int i = 0; i < N; ++i)
+	{
+		int a = agg[block[i]];
+		int& c = col[(size_t)a*maxComp + comp[i]];
+		if (c == -1)
+		{
+			c = NC++;
+			cblock.push_back(a);
+			ccomp.push_back(comp[i]);
+		}
+		Tc[i] = c;
+	}
+
+	// stop if the coarsening is not effective
+	if ((NC == 0) || (NC >= 0.9*N)) return false;
+
+	vector<double> colCount(NC, 0.0);
+	for (int i = 0; i < N; ++i) colCount[Tc[i]] += 1.0;
+
+	CSRMatrix T;
+	T.rows = N;
+	T.cols = NC;
+	T.p.resize(N + 1);
+	T.c.resize(N);
+	T.v.resize(N);
+	for (int i = 0; i < N; ++i)
+	{
+		T.p[i] = i;
+		T.c[i] = Tc[i];
+		T.v[i] = 1.0 / sqrt(colCount[Tc[i]]);
+	}
+	T.p[N] = N;
+
+	// estimate the spectral radius of D^-1*A with a few power iterations
+	vector<double> Dinv(N, 0.0);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = A.p[i]; k < A.p[i + 1]; ++k)
+			if ((A.c[k] == i) && (A.v[k] != 0.0)) Dinv[i] = 1.0 / A.v[k];
+	}
+
+	vector<double> u(N), w(N);
+	for (int i = 0; i < N; ++i) u[i] = 1.0 + (i % 7)*0.1;
+	double rho = 1.0;
+	for (int iter = 0; iter < 15; ++iter)
+	{
+		A.mult(&u[0], &w[0]);
+		double norm = 0.0;
+		for (int i = 0; i < N; ++i) { w[i] *= Dinv[i]; norm += w[i] * w[i]; }
+		norm = sqrt(norm);
+		if (norm == 0.0) break;
+		double unorm = 0.0;
+		for (int i = 0; i < N; ++i) unorm += u[i] * u[i];
+		rho = norm / sqrt(unorm);
+		for (int i = 0; i < N; ++i) u[i] = w[i] / norm;
+	}
+	double omega = 4.0 / (3.0*rho);
+
+	// smooth the prolongator: P = (I - omega*D^-1*A)*T
+	CSRMatrix P;
+	multiply(A, T, P);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = P.p[i]; k < P.p[i + 1]; ++k)
+		{
+			P.v[k] *= -omega*Dinv[i];
+			if (P.c[k] == Tc[i]) P.v[k] += T.v[i];
+		}
+	}
+
+	// Galerkin coarse matrix Ac = R*A*P, with R = P^T
+	Level& L = m_level[l];
+	L.P = P;
+	transpose(P, L.R);
+	CSRMatrix AP;
+	multiply(A, P, AP);
+
+	Level C;
+	multiply(L.R, AP, C.A);
+	C.block = cblock;
+	C.comp = ccomp;
+	C.nblocks = nagg;
+	m_level.push_back(C);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// do a dense LU factorization (with partial pivoting) of the coarsest matrix
+bool AMG_Preconditioner::FactorCoarse()
+{
+	const CSRMatrix& A = m_level.back().A;
+	const int N = A.rows;
+
+	// The coarsening can stall (or reach the max nr of levels) before the coarse
+	// level is small enough. The dense factorization is then not feasible, so the
+	// coarsest level will only be smoothed.
+	if ((N > m_maxCoarse) && (N > AMG_MAX_DENSE_COARSE))
+	{
+		feLogWarning("AMG: The coarsest level has %d equations, which is too large for a direct solve.\nThe coarsest level will be smoothed instead.", N);
+		m_LU.clear();
+		m_piv.clear();
+		return true;
+	}
+
+	m_LU.assign((size_t)N*N, 0.0);
+	m_piv.resize(N);
+	for (int i = 0; i < N; ++i)
+		for (int k = A.p[i]; k < A.p[i + 1]; ++k) m_LU[(size_t)i*N + A.c[k]] += A.v[k];
+
+	double amax = 0.0;
+	for (size_t i = 0; i < m_LU.size(); ++i) if (fabs(m_LU[i]) > amax) amax = fabs(m_LU[i]);
+	if (amax == 0.0) amax = 1.0;
+
+	for (int k = 0; k < N; ++k)
+	{
+		int p = k;
+		for (int i = k + 1; i < N; ++i) if (fabs(m_LU[(size_t)i*N + k]) > fabs(m_LU[(size_t)p*N + k])) p = i;
+		m_piv[k] = p;
+		if (p != k) for (int j = 0; j < N; ++j) std::swap(m_LU[(size_t)k*N + j], m_LU[(size_t)p*N + j]);
+
+		// the coarse matrix can be singular (e.g. for problems without essential boundary conditions)
+		double* Lk = &m_LU[(size_t)k*N];
+		if (fabs(Lk[k]) < 1e-14*amax) { Lk[k] = amax; continue; }
+
+#pragma omp parallel for if (N - k > 128)
+		for (int i = k + 1; i < N; ++i)
+		{
+			double* Li = &m_LU[(size_t)i*N];
+			double f = Li[k] / Lk[k];
+			Li[k] = f;
+			if (f != 0.0) for (int j = k + 1; j < N; ++j) Li[j] -= f*Lk[j];
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void AMG_Preconditioner::SolveCoarse(double* x, const double* b)
+{
+	const int N = (int)m_piv.size();
+	for (int i = 0; i < N; ++i) x[i] = b[i];
+	for (int k = 0; k < N; ++k)
+	{
+		if (m_piv[k] != k) std::swap(x[k], x[m_piv[k]]);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		const double* Li = &m_LU[(size_t)i*N];
+		double s = x[i];
+		for (int j = 0; j < i; ++j) s -= Li[j] * x[j];
+		x[i] = s;
+	}
+	for (int i = N - 1; i >= 0; --i)
+	{
+		const double* Ui = &m_LU[(size_t)i*N];
+		double s = x[i];
+		for (int j = i + 1; j < N; ++j) s -= Ui[j] * x[j];
+		x[i] = s / Ui[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+// (weighted) Jacobi smoothing: x += w*D^-1*(b - A*x)
+void AMG_Preconditioner::Smooth(Level& L, bool zeroGuess, int niter)
+{
+	const int N = L.A.rows;
+	const double w = m_jacobiWeight;
+	for (int n = 0; n < niter; ++n)
+	{
+		if (zeroGuess && (n == 0))
+		{
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < N; ++i) L.x[i] = w*L.Dinv[i] * L.b[i];
+		}
+		else
+		{
+			L.A.mult(&L.x[0], &L.r[0]);
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < N; ++i) L.x[i] += w*L.Dinv[i] * (L.b[i] - L.r[i]);
+		}
+	}
+	if (zeroGuess && (niter <= 0)) L.x.assign(N, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void AMG_Preconditioner::VCycle(int l)
+{
+	Level& L = m_level[l];
+	const int N = L.A.rows;
+
+	// coarsest level
+	if (l == (int)m_level.size() - 1)
+	{
+		if (m_piv.empty()) Smooth(L, true, AMG_COARSE_SMOOTH_ITERS);
+		else SolveCoarse(&L.x[0], &L.b[0]);
+		return;
+	}
+
+	// pre-smoothing
+	Smooth(L, true, m_nsmooth);
+
+	// restrict the residual
+	L.A.mult(&L.x[0], &L.r[0]);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i) L.r[i] = L.b[i] - L.r[i];
+	Level& C = m_level[l + 1];
+	L.R.mult(&L.r[0], &C.b[0]);
+
+	// coarse grid correction
+	VCycle(l + 1);
+	L.P.mult(&C.x[0], &L.r[0]);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i) L.x[i] += L.r[i];
+
+	// post-smoothing
+	Smooth(L, false, m_nsmooth);
+}
+
+//-----------------------------------------------------------------------------
+// apply one V-cycle to calculate x = P^-1*y
+bool AMG_Preconditioner::BackSolve(double* x, double* y)
+{
+	if (m_level.empty()) return false;
+	Level& L = m_level[0];
+	const int N = L.A.rows;
+	for (int i = 0; i < N; ++i) L.b[i] = y[i];
+	VCycle(0);
+	for (int i = 0; i < N; ++i) x[i] = L.x[i];
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void AMG_Preconditioner::Destroy()
+{
+	m_level.clear();
+	m_LU.clear();
+	m_piv.clear();
+	Preconditioner::Destroy();
+}
@@ -0,0 +1,110 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/Preconditioner.h>
+
+//-----------------------------------------------------------------------------
+//! Smoothed aggregation algebraic multigrid preconditioner. 
+
+//! This preconditioner does not depend on any third-party library. The 
+//! aggregation is block-aware: all the equations of a node are aggregated 
+//! together so that the displacement (or velocity) components of a node stay
+//! on the same coarse node. The tentative prolongation uses one coarse 
+//! equation per aggregate and nodal degree of freedom, which is smoothed 
+//! with a damped Jacobi step. The preconditioner applies one V-cycle with 
+//! (weighted) Jacobi smoothing, and a dense LU solve on the coarsest level (or
+//! only smoothing, if the coarsest level is too large for a dense solve).
+class AMG_Preconditioner : public Preconditioner
+{
+	// sparse matrix in compressed row storage (zero-based) used for the hierarchy
+	struct CSRMatrix
+	{
+		int	rows, cols;
+		vector<int>		p;	// row pointers
+		vector<int>		c;	// column indices
+		vector<double>	v;	// values
+
+		void mult(const double* x, double* y) const;
+	};
+
+	// data for one level of the hierarchy
+	struct Level
+	{
+		CSRMatrix	A;			// matrix of this level
+		CSRMatrix	P;			// prolongation to this level from the next (coarser) level
+		CSRMatrix	R;			// restriction from this level to the next level
+		vector<double>	Dinv;	// inverse of the diagonal of A
+		vector<int>	block;		// block (i.e. node or aggregate) each equation belongs to
+		vector<int>	comp;		// component of each equation in its block
+		int			nblocks;	// number of blocks
+
+		vector<double>	x, b, r;	// work vectors
+	};
+
+public:
+	AMG_Preconditioner(FEModel* fem);
+
+	// create sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	// build the multigrid hierarchy
+	bool Factor() override;
+
+	// apply to vector P x = y
+	bool BackSolve(double* x, double* y) override;
+
+	// clean up
+	void Destroy() override;
+
+public:
+	int		m_maxLevels;		//!< max number of levels
+	int		m_maxCoarse;		//!< max number of equations on the coarsest level
+	double	m_theta;			//!< strength of connection threshold
+	int		m_nsmooth;			//!< number of pre- and post-smoothing iterations
+	double	m_jacobiWeight;		//!< weight of the Jacobi smoother
+	int		m_blockSize;		//!< block size (0 = use the nodal equation numbers)
+
+private:
+	bool BuildFineMatrix(CSRMatrix& A);
+	void BuildBlocks(Level& L);
+	bool Coarsen(int l);
+	bool FactorCoarse();
+	void SolveCoarse(double* x, const double* b);
+	void VCycle(int l);
+	void Smooth(Level& L, bool zeroGuess, int niter);
+
+	static void multiply(const CSRMatrix& A, const CSRMatrix& B, CSRMatrix& C);
+	static void transpose(const CSRMatrix& A, CSRMatrix& At);
+
+private:
+	vector<Level>	m_level;	//!< the multigrid hierarchy
+	vector<double>	m_LU;		//!< dense LU factorization of coarsest matrix
+	vector<int>		m_piv;		//!< pivots of LU factorization
+
+	DECLARE_FECORE_CLASS();
+};
@@ -0,0 +1,402 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "BCSRMatrix.h"
+#include "CompactUnSymmMatrix.h"
+#include <algorithm>
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+BCSRMatrix::BCSRMatrix(int blockSize)
+{
+	assert(blockSize > 0);
+	m_bs = blockSize;
+	m_nbr = 0;
+	m_maxbs = 0;
+}
+
+//-----------------------------------------------------------------------------
+BCSRMatrix::~BCSRMatrix()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::SetBlockSize(int bs)
+{
+	assert(bs > 0);
+	assert(m_bcol.empty());
+	m_bs = bs;
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::SetBlockPartition(const std::vector<int>& bp)
+{
+	assert(m_bcol.empty());
+	m_part = bp;
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::Clear()
+{
+	m_nbr = 0;
+	m_maxbs = 0;
+	m_bp.clear(); m_bp.shrink_to_fit();
+	m_eqb.clear(); m_eqb.shrink_to_fit();
+	m_brow.clear(); m_brow.shrink_to_fit();
+	m_bcol.clear(); m_bcol.shrink_to_fit();
+	m_boff.clear(); m_boff.shrink_to_fit();
+	m_val.clear(); m_val.shrink_to_fit();
+	SparseMatrix::Clear();
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::Create(SparseMatrixProfile& mp)
+{
+	int nr = mp.Rows();
+	int nc = mp.Columns();
+	assert(nr == nc);
+
+	// setup the block partition
+	m_bp.clear();
+	m_bp.push_back(0);
+	if ((m_part.size() > 1) && (m_part[0] == 0) && (m_part.back() <= nr))
+	{
+		// use the requested partition, but put the remaining equations in 1x1 blocks
+		m_bp = m_part;
+		for (int i = m_part.back() + 1; i <= nr; ++i) m_bp.push_back(i);
+	}
+	else
+	{
+		// use uniform blocks
+		for (int i = m_bs; i < nr; i += m_bs) m_bp.push_back(i);
+		if (nr > 0) m_bp.push_back(nr);
+	}
+	m_nbr = (int)m_bp.size() - 1;
+
+	m_maxbs = 0;
+	m_eqb.resize(nr);
+	for (int I = 0; I < m_nbr; ++I)
+	{
+		assert(m_bp[I + 1] > m_bp[I]);
+		int bs = m_bp[I + 1] - m_bp[I];
+		if (bs > m_maxbs) m_maxbs = bs;
+		for (int i = m_bp[I]; i < m_bp[I + 1]; ++i) m_eqb[i] = I;
+	}
+
+	// collect the block columns of each block row. Since we process the 
+	// columns in order, these lists are automatically sorted.
+	std::vector< std::vector<int> > rowBlocks(m_nbr);
+	for (int j = 0; j<nc; ++j)
+	{
+		int J = m_eqb[j];
+		SparseMatrixProfile::ColumnProfile& a = mp.Column(j);
+		int n = a.size();
+		for (int k = 0; k<n; ++k)
+		{
+			int I0 = m_eqb[a[k].start];
+			int I1 = m_eqb[a[k].end];
+			for (int I = I0; I <= I1; ++I)
+			{
+				std::vector<int>& row = rowBlocks[I];
+				if (row.empty() || (row.back() != J)) row.push_back(J);
+			}
+		}
+	}
+
+	// build the compressed block structure
+	m_brow.assign(m_nbr + 1, 0);
+	for (int I = 0; I<m_nbr; ++I) m_brow[I + 1] = m_brow[I] + (int)rowBlocks[I].size();
+
+	int nblocks = m_brow[m_nbr];
+	m_bcol.resize(nblocks);
+	m_boff.resize(nblocks + 1);
+	m_boff[0] = 0;
+	for (int I = 0; I<m_nbr; ++I)
+	{
+		std::copy(rowBlocks[I].begin(), rowBlocks[I].end(), m_bcol.begin() + m_brow[I]);
+
+		int ri = m_bp[I + 1] - m_bp[I];
+		for (int k = m_brow[I]; k < m_brow[I + 1]; ++k)
+		{
+			int J = m_bcol[k];
+			m_boff[k + 1] = m_boff[k] + ri*(m_bp[J + 1] - m_bp[J]);
+		}
+	}
+
+	// allocate the values
+	m_val.assign(m_boff[nblocks], 0.0);
+
+	m_nrow = nr;
+	m_ncol = nc;
+	m_nsize = m_boff[nblocks];
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::Zero()
+{
+	std::fill(m_val.begin(), m_val.end(), 0.0);
+}
+
+//-----------------------------------------------------------------------------
+int BCSRMatrix::findOffset(int i, int j) const
+{
+	int I = m_eqb[i];
+	int J = m_eqb[j];
+
+	// find the block via bisection (block columns are sorted)
+	std::vector<int>::const_iterator it0 = m_bcol.begin() + m_brow[I];
+	std::vector<int>::const_iterator it1 = m_bcol.begin() + m_brow[I + 1];
+	std::vector<int>::const_iterator it = std::lower_bound(it0, it1, J);
+	if ((it == it1) || (*it != J)) return -1;
+
+	int k = (int)(it - m_bcol.begin());
+	int cj = m_bp[J + 1] - m_bp[J];
+	return m_boff[k] + (i - m_bp[I])*cj + (j - m_bp[J]);
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::Assemble(const matrix& ke, const std::vector<int>& lm)
+{
+	Assemble(ke, lm, lm);
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj)
+{
+	const int N = ke.rows();
+	const int M = ke.columns();
+	double* pv = (m_val.empty() ? nullptr : &m_val[0]);
+	for (int i = 0; i<N; ++i)
+	{
+		int I = lmi[i];
+		if (I < 0) continue;
+		const double* ki = ke[i];
+		for (int j = 0; j<M; ++j)
+		{
+			int J = lmj[j];
+			if (J < 0) continue;
+
+			int n = findOffset(I, J);
+			assert(n >= 0);
+			if (n >= 0)
+			{
+				if (m_batomic)
+				{
+#pragma omp atomic
+					pv[n] += ki[j];
+				}
+				else pv[n] += ki[j];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool BCSRMatrix::AssemblyMap(int nr, int nc, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = lmi[i];
+		if (I < 0) continue;
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = lmj[j];
+			if (J >= 0) map[i*nc + j] = findOffset(I, J);
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool BCSRMatrix::check(int i, int j)
+{
+	return (findOffset(i, j) >= 0);
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::set(int i, int j, double v)
+{
+	int n = findOffset(i, j);
+	assert(n >= 0);
+	if (n >= 0) m_val[n] = v;
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::add(int i, int j, double v)
+{
+	int n = findOffset(i, j);
+	assert(n >= 0);
+	if (n >= 0)
+	{
+		if (m_batomic)
+		{
+#pragma omp atomic
+			m_val[n] += v;
+		}
+		else m_val[n] += v;
+	}
+}
+
+//-----------------------------------------------------------------------------
+double BCSRMatrix::get(int i, int j)
+{
+	int n = findOffset(i, j);
+	return (n >= 0 ? m_val[n] : 0.0);
+}
+
+//-----------------------------------------------------------------------------
+double BCSRMatrix::diag(int i)
+{
+	return get(i, i);
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::scale(const std::vector<double>& L, const std::vector<double>& R)
+{
+	assert(L.size() == Rows());
+	assert(R.size() == Columns());
+
+#pragma omp parallel for schedule(static)
+	for (int I = 0; I<m_nbr; ++I)
+	{
+		const int i0 = m_bp[I];
+		const int ri = m_bp[I + 1] - i0;
+		for (int k = m_brow[I]; k<m_brow[I + 1]; ++k)
+		{
+			int J = m_bcol[k];
+			const int j0 = m_bp[J];
+			const int cj = m_bp[J + 1] - j0;
+			double* pb = &m_val[m_boff[k]];
+			for (int a = 0; a<ri; ++a, pb += cj)
+			{
+				double li = L[i0 + a];
+				for (int b = 0; b<cj; ++b) pb[b] *= li * R[j0 + b];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Each block row writes to its own part of the result vector, so the 
+// block rows can be processed in parallel.
+bool BCSRMatrix::mult_vector(double* x, double* r)
+{
+	const double* pv = (m_val.empty() ? nullptr : &m_val[0]);
+
+#pragma omp parallel
+	{
+		std::vector<double> rb(m_maxbs);
+
+#pragma omp for schedule(static)
+		for (int I = 0; I<m_nbr; ++I)
+		{
+			const int i0 = m_bp[I];
+			const int ri = m_bp[I + 1] - i0;
+			for (int a = 0; a<ri; ++a) rb[a] = 0.0;
+
+			for (int k = m_brow[I]; k<m_brow[I + 1]; ++k)
+			{
+				int J = m_bcol[k];
+				const int j0 = m_bp[J];
+				const int cj = m_bp[J + 1] - j0;
+				const double* pb = pv + m_boff[k];
+				const double* xb = x + j0;
+				for (int a = 0; a<ri; ++a, pb += cj)
+				{
+					double s = 0.0;
+					for (int b = 0; b<cj; ++b) s += pb[b] * xb[b];
+					rb[a] += s;
+				}
+			}
+
+			for (int a = 0; a<ri; ++a) r[i0 + a] = rb[a];
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void BCSRMatrix::ToCRS(CRSSparseMatrix& A) const
+{
+	const int nr = m_nrow;
+	const int nc = m_ncol;
+	const int offset = A.Offset();
+
+	// count the entries in each row
+	int* pointers = new int[nr + 1];
+	pointers[0] = 0;
+	for (int I = 0; I<m_nbr; ++I)
+	{
+		int ncols = 0;
+		for (int k = m_brow[I]; k<m_brow[I + 1]; ++k)
+		{
+			int J = m_bcol[k];
+			ncols += m_bp[J + 1] - m_bp[J];
+		}
+
+		for (int i = m_bp[I]; i<m_bp[I + 1]; ++i) pointers[i + 1] = pointers[i] + ncols;
+	}
+
+	// copy the entries
+	int nsize = pointers[nr];
+	int* indices = new int[nsize];
+	double* values = new double[nsize];
+	for (int I = 0; I<m_nbr; ++I)
+	{
+		const int i0 = m_bp[I];
+		const int ri = m_bp[I + 1] - i0;
+		for (int a = 0; a<ri; ++a)
+		{
+			int n = pointers[i0 + a];
+			for (int k = m_brow[I]; k<m_brow[I + 1]; ++k)
+			{
+				int J = m_bcol[k];
+				const int j0 = m_bp[J];
+				const int cj = m_bp[J + 1] - j0;
+				const double* pb = &m_val[m_boff[k] + a*cj];
+				for (int b = 0; b<cj; ++b, ++n)
+				{
+					indices[n] = j0 + b + offset;
+					values[n] = pb[b];
+				}
+			}
+		}
+	}
+	if (offset)
+	{
+		for (int i = 0; i <= nr; ++i) pointers[i] += offset;
+	}
+
+	A.alloc(nr, nc, nsize, values, indices, pointers);
+}
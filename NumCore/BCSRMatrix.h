@@ -0,0 +1,133 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <FECore/SparseMatrix.h>
+
+class CRSSparseMatrix;
+
+//=============================================================================
+//! This class stores a sparse matrix in block compressed row storage (BCSR) format.
+//! The equations are partitioned in blocks of consecutive equations (e.g. the 
+//! equations of a node) and the same partition is used for the rows and columns.
+//! A block (I,J) is stored as a dense array (row major) if any of its entries is in 
+//! the matrix profile. This only requires one column index per block. The blocks 
+//! can have different sizes, so that nodes with fixed degrees of freedom, which have
+//! no equations, do not shift the block boundaries. The full matrix is stored, even 
+//! if it is symmetric.
+class BCSRMatrix : public SparseMatrix
+{
+public:
+	//! constructor
+	BCSRMatrix(int blockSize = 3);
+
+	//! destructor
+	~BCSRMatrix();
+
+	//! Set a uniform block size (must be called before Create). This is used 
+	//! when no block partition is set. 
+	void SetBlockSize(int bs);
+
+	//! Set the block partition (must be called before Create). Block I consists
+	//! of equations bp[I] to bp[I+1]-1. Equations beyond the end of the partition
+	//! are placed in blocks of size one. 
+	void SetBlockPartition(const std::vector<int>& bp);
+
+	//! return the number of block rows
+	int BlockRows() const { return m_nbr; }
+
+	//! return the number of blocks
+	int Blocks() const { return (int)m_bcol.size(); }
+
+public:
+	//! Create the matrix structure from the SparseMatrixProfile
+	void Create(SparseMatrixProfile& mp) override;
+
+	//! zero all matrix elements
+	void Zero() override;
+
+	//! release all memory
+	void Clear() override;
+
+	//! Assemble the element matrix into the global matrix
+	void Assemble(const matrix& ke, const std::vector<int>& lm) override;
+
+	//! assemble a matrix into the sparse matrix
+	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override;
+
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map) override;
+
+	//! see if a matrix element is defined
+	bool check(int i, int j) override;
+
+	//! set the matrix item
+	void set(int i, int j, double v) override;
+
+	//! add a value to the matrix item
+	void add(int i, int j, double v) override;
+
+	//! get a matrix item
+	double get(int i, int j) override;
+
+	//! return the diagonal value
+	double diag(int i) override;
+
+	//! do row (L) and column (R) scaling
+	void scale(const std::vector<double>& L, const std::vector<double>& R) override;
+
+	//! multiply with vector
+	bool mult_vector(double* x, double* r) override;
+
+	//! pointer to the block values
+	double* Values() override { return (m_val.empty() ? nullptr : &m_val[0]); }
+
+public:
+	//! Convert to a scalar compressed row storage matrix (e.g. for external solvers).
+	//! All entries of the stored blocks are copied. The offset (0 or 1) of A is used.
+	void ToCRS(CRSSparseMatrix& A) const;
+
+private:
+	//! find the offset of entry (i,j) in the values array (or -1 if the entry is not stored)
+	int findOffset(int i, int j) const;
+
+private:
+	int		m_bs;		//!< uniform block size (used when no partition is set)
+	int		m_nbr;		//!< number of block rows (and columns)
+	int		m_maxbs;	//!< largest block size
+
+	std::vector<int>	m_part;	//!< requested block partition
+	std::vector<int>	m_bp;	//!< first equation of each block (size = m_nbr + 1)
+	std::vector<int>	m_eqb;	//!< block of each equation
+	std::vector<int>	m_brow;	//!< offset of the first block of each block row (size = m_nbr + 1)
+	std::vector<int>	m_bcol;	//!< block column index of each block
+	std::vector<int>	m_boff;	//!< offset of each block in the values array (size = Blocks() + 1)
+	std::vector<double>	m_val;	//!< block values
+};
@@ -26,7 +26,10 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "BiCGStabSolver.h"
 #include "CompactUnSymmMatrix.h"
+#include "BCSRMatrix.h"
 #include <FECore/log.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
 
 //-----------------------------------------------------------------------------
 BEGIN_FECORE_CLASS(BiCGStabSolver, IterativeLinearSolver)
@@ -34,6 +37,8 @@ BEGIN_FECORE_CLASS(BiCGStabSolver, IterativeLinearSolver)
 	ADD_PARAMETER(m_tol, "tol");
 	ADD_PARAMETER(m_maxiter, "max_iter");
 	ADD_PARAMETER(m_fail_max_iter, "fail_max_iters");
+	ADD_PARAMETER(m_bparMult, "parallel_mult");
+	ADD_PARAMETER(m_bnodalBlocks, "nodal_blocks");
 	ADD_PROPERTY(m_P, "pc_left");
 END_FECORE_CLASS();
 
@@ -45,6 +50,44 @@ BiCGStabSolver::BiCGStabSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(
 	m_abstol = 0.0;
 	m_print_level = 0;
 	m_fail_max_iter = true;
+	m_bparMult = true;
+	m_bnodalBlocks = false;
+}
+
+//-----------------------------------------------------------------------------
+// Partition the equations in blocks of consecutive equations that belong to 
+// the same node. The blocks follow the equation numbers of the nodes, so they
+// don't depend on the number of (fixed) degrees of freedom of a node or on the
+// equation ordering. Equations that are not assigned to a node get their own block.
+static void NodalBlockPartition(FEMesh& mesh, vector<int>& bp)
+{
+	// find the node of each equation
+	vector<int> eqNode;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		const vector<int>& id = mesh.Node(i).m_ID;
+		for (size_t j = 0; j < id.size(); ++j)
+		{
+			// prescribed dofs also have an equation number
+			int n = id[j];
+			if (n < -1) n = -n - 2;
+			if (n >= 0)
+			{
+				if (n >= (int)eqNode.size()) eqNode.resize(n + 1, -1);
+				eqNode[n] = i;
+			}
+		}
+	}
+
+	// a new block starts when the node changes
+	int neq = (int)eqNode.size();
+	bp.clear();
+	bp.push_back(0);
+	for (int i = 1; i < neq; ++i)
+	{
+		if ((eqNode[i] < 0) || (eqNode[i] != eqNode[i - 1])) bp.push_back(i);
+	}
+	if (neq > 0) bp.push_back(neq);
 }
 
 //-----------------------------------------------------------------------------
@@ -57,6 +100,15 @@ SparseMatrix* BiCGStabSolver::CreateSparseMatrix(Matrix_Type ntype)
 		m_P->SetPartitions(m_part);
 		m_pA = m_P->CreateSparseMatrix(ntype);
 	}
+	else if (m_bnodalBlocks)
+	{
+		// store the full matrix in nodal blocks
+		BCSRMatrix* A = new BCSRMatrix;
+		vector<int> bp;
+		NodalBlockPartition(GetFEModel()->GetMesh(), bp);
+		A->SetBlockPartition(bp);
+		m_pA = A;
+	}
 	else
 	{
 		if (ntype == REAL_SYMMETRIC) m_pA = new CompactSymmMatrix;
@@ -93,6 +145,10 @@ bool BiCGStabSolver::HasPreconditioner() const
 //-----------------------------------------------------------------------------
 bool BiCGStabSolver::PreProcess()
 {
+	// use the multithreaded matrix-vector product for symmetric matrices
+	CompactSymmMatrix* K = dynamic_cast<CompactSymmMatrix*>(m_pA);
+	if (K) K->UseParallelMultiply(m_bparMult);
+
 	return true;
 }
 
@@ -60,6 +60,8 @@ protected:
 	double	m_abstol;		// absolute residual tolerance
 	int		m_print_level;	// output level
 	double	m_fail_max_iter;
+	bool	m_bparMult;		// use multithreaded matrix-vector product
+	bool	m_bnodalBlocks;	// store the matrix in nodal blocks (block compressed row storage)
 
 	DECLARE_FECORE_CLASS();
 };
@@ -222,6 +222,15 @@ void BlockMatrix::Clear()
 	for (int i=0; i<n; ++i) m_Block[i].pA->Clear();
 }
 
+//-----------------------------------------------------------------------------
+//! turn atomic assembly on or off for all blocks
+void BlockMatrix::SetAtomicAssembly(bool b)
+{
+	SparseMatrix::SetAtomicAssembly(b);
+	const int n = (int) m_Block.size();
+	for (int i=0; i<n; ++i) m_Block[i].pA->SetAtomicAssembly(b);
+}
+
 //-----------------------------------------------------------------------------
 //! Zero all matrix elements
 void BlockMatrix::Zero()
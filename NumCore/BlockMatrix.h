@@ -92,6 +92,9 @@ public:
 	//! release memory for storing data
 	void Clear() override;
 
+	//! turn atomic assembly on or off
+	void SetAtomicAssembly(bool b) override;
+
 	//! zero matrix elements
 	void Zero() override;
 
@@ -33,12 +33,29 @@ SOFTWARE.*/
 //! constructor
 CompactSymmMatrix::CompactSymmMatrix(int offset) : CompactMatrix(offset) 
 {
-	
+	m_bparMult = false;
+}
+
+//-----------------------------------------------------------------------------
+void CompactSymmMatrix::Clear()
+{
+	// the row structure is no longer valid
+	m_rowPtr.clear();
+	m_rowCol.clear();
+	m_rowVal.clear();
+
+	CompactMatrix::Clear();
 }
 
 //-----------------------------------------------------------------------------
 bool CompactSymmMatrix::mult_vector(double* x, double* r)
 {
+	if (m_bparMult)
+	{
+		mult_vector_parallel(x, r);
+		return true;
+	}
+
 	// get row count
 	int N = Rows();
 	int M = Columns();
@@ -94,6 +111,76 @@ bool CompactSymmMatrix::mult_vector(double* x, double* r)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// The serial product scatters the lower triangular part of each column into the
+// result vector, which cannot be done in parallel without write conflicts. Instead,
+// we also store for each row the position of its lower triangular entries, so that
+// each component of the result only requires reads.
+void CompactSymmMatrix::BuildRowIndices()
+{
+	int N = Rows();
+	const int* pp = m_ppointers;
+	const int* pi = m_pindices;
+	const int off = m_offset;
+
+	// count the (off-diagonal) entries in each row
+	m_rowPtr.assign(N + 1, 0);
+	for (int j = 0; j<N; ++j)
+	{
+		for (int k = pp[j] + 1; k < pp[j + 1]; ++k) m_rowPtr[pi[k - off] - off + 1]++;
+	}
+	for (int i = 0; i<N; ++i) m_rowPtr[i + 1] += m_rowPtr[i];
+
+	// fill the row structure (columns are processed in order, so each row is sorted)
+	int nnz = m_rowPtr[N];
+	m_rowCol.resize(nnz);
+	m_rowVal.resize(nnz);
+	vector<int> pos(m_rowPtr.begin(), m_rowPtr.end() - 1);
+	for (int j = 0; j<N; ++j)
+	{
+		for (int k = pp[j] + 1; k < pp[j + 1]; ++k)
+		{
+			int i = pi[k - off] - off;
+			int n = pos[i]++;
+			m_rowCol[n] = j;
+			m_rowVal[n] = k - off;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CompactSymmMatrix::mult_vector_parallel(const double* x, double* r)
+{
+	int N = Rows();
+
+	// build the row structure, if necessary (it is cleared when the matrix structure changes)
+	if (m_rowPtr.empty()) BuildRowIndices();
+
+	const int* pp = m_ppointers;
+	const int* pi = m_pindices;
+	const int* rp = &m_rowPtr[0];
+	const int* rc = (m_rowCol.empty() ? nullptr : &m_rowCol[0]);
+	const int* rv = (m_rowVal.empty() ? nullptr : &m_rowVal[0]);
+	const double* pd = m_pd;
+	const int off = m_offset;
+
+#pragma omp parallel for schedule(static) if (N > 1000)
+	for (int j = 0; j<N; ++j)
+	{
+		// diagonal and upper-triangular elements (i.e. column j)
+		const double* pv = pd + pp[j] - off;
+		const int* pij = pi + pp[j] - off;
+		int n = pp[j + 1] - pp[j];
+		double rj = pv[0] * x[j];
+		for (int i = 1; i<n; ++i) rj += pv[i] * x[pij[i] - off];
+
+		// lower-triangular elements (i.e. row j)
+		for (int k = rp[j]; k < rp[j + 1]; ++k) rj += pd[rv[k]] * x[rc[k]];
+
+		r[j] = rj;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void CompactSymmMatrix::Create(SparseMatrixProfile& mp)
 {
@@ -102,6 +189,11 @@ void CompactSymmMatrix::Create(SparseMatrixProfile& mp)
 	int nc = mp.Columns();
 	assert(nr==nc);
 
+	// the row structure is no longer valid
+	m_rowPtr.clear();
+	m_rowCol.clear();
+	m_rowVal.clear();
+
 	// allocate pointers to column offsets
 	int* pointers = new int[nc + 1];
 	for (int i = 0; i <= nc; ++i) pointers[i] = 0;
@@ -189,7 +281,8 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This must be a local array since this function can be called concurrently.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -220,8 +313,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-					#pragma omp atomic
-					pm[n] += ke[i][j];
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -256,8 +353,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 				for (int n = 0; n<l; ++n) 
 					if (pi[n] - m_offset == I)
 					{
-						#pragma omp atomic
-						pv[n] += ke[i][j];
+						if (m_batomic)
+						{
+							#pragma omp atomic
+							pv[n] += ke[i][j];
+						}
+						else pv[n] += ke[i][j];
 						break;
 					}
 			}
@@ -265,6 +366,24 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Calculate the assembly map of an element matrix. Only the lower-triangular
+//! entries are assembled, so all other entries are mapped to -1.
+bool CompactSymmMatrix::AssemblyMap(int nr, int nc, const vector<int>& LMi, const vector<int>& LMj, vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = LMi[i];
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = LMj[j];
+			if ((I >= J) && (J >= 0)) map[i*nc + j] = findOffset(J, I);
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! add a matrix item
 void CompactSymmMatrix::add(int i, int j, double v)
@@ -288,8 +407,12 @@ void CompactSymmMatrix::add(int i, int j, double v)
 			int m = pi[n];
 			if (m == i)
 			{
-				#pragma omp atomic
-				pd[n] += v;
+				if (m_batomic)
+				{
+					#pragma omp atomic
+					pd[n] += v;
+				}
+				else pd[n] += v;
 				return;
 			}
 			else if (m < i)
@@ -44,12 +44,18 @@ public:
 	//! Create the matrix structure from the SparseMatrixProfile.
 	void Create(SparseMatrixProfile& mp) override;
 
+	//! clear all data
+	void Clear() override;
+
 	//! Assemble an element matrix into the global matrix
 	void Assemble(const matrix& ke, const vector<int>& lm) override;
 
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const vector<int>& lmi, const vector<int>& lmj, vector<int>& map) override;
+
 	//! add a matrix item
 	void add(int i, int j, double v) override;
 
@@ -85,4 +91,23 @@ public:
 
 	//! do row (L) and column (R) scaling
 	void scale(const vector<double>& L, const vector<double>& R) override;
+
+public:
+	//! Use the multithreaded matrix-vector product. This uses the row structure 
+	//! of the lower triangular part (which is calculated on first use) so that 
+	//! each row of the result can be evaluated independently.
+	void UseParallelMultiply(bool b) { m_bparMult = b; }
+
+private:
+	//! build the row structure of the lower triangular part
+	void BuildRowIndices();
+
+	//! multithreaded matrix-vector product
+	void mult_vector_parallel(const double* x, double* r);
+
+private:
+	bool			m_bparMult;	//!< use multithreaded matrix-vector product
+	vector<int>		m_rowPtr;	//!< row pointers into m_rowCol and m_rowVal
+	vector<int>		m_rowCol;	//!< column index of each lower triangular entry in a row
+	vector<int>		m_rowVal;	//!< position of each lower triangular entry in the values array
 };
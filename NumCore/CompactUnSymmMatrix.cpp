@@ -201,7 +201,8 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This must be a local array since this function can be called concurrently.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -233,8 +234,12 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == J)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += kij;
+						pm[n] += kij;
+					}
+					else pm[n] += kij;
 					break;
 				}
 		}
@@ -261,6 +266,24 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const v
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! calculate the assembly map of an element matrix
+bool CRSSparseMatrix::AssemblyMap(int nr, int nc, const vector<int>& LMi, const vector<int>& LMj, vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = LMi[i];
+		if (I < 0) continue;
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = LMj[j];
+			if (J >= 0) map[i*nc + j] = findOffset(I, J);
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // This algorithm uses a binary search for locating the correct row index
 // This assumes that the indices are ordered!
@@ -280,8 +303,12 @@ void CRSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == j)
 		{
+			if (m_batomic)
+			{
 #pragma omp atomic
-			pd[n] += v;
+				pd[n] += v;
+			}
+			else pd[n] += v;
 			return;
 		}
 		else if (m < j)
@@ -359,38 +386,33 @@ double CRSSparseMatrix::diag(int i)
 //-----------------------------------------------------------------------------
 bool CRSSparseMatrix::mult_vector(double* x, double* r)
 {
-#ifdef MKL_ISS
-
 	// get the matrix size
 	const int N = Rows();
 
+#ifdef MKL_ISS
 	if (Offset() == 1)
 	{
 		const char transa = 'N';
 		mkl_dcsrgemv(&transa, &N, m_pd, m_ppointers, m_pindices, x, r);
+		return true;
 	}
-	else
-	{
-		assert(m_offset == 0);
-		// loop over all rows
-	#pragma omp parallel for schedule(guided)
-		for (int i = 0; i < N; ++i)
+#endif
+
+	// loop over all rows
+#pragma omp parallel for schedule(guided)
+	for (int i = 0; i < N; ++i)
+	{
+		const double* pv = m_pd + (m_ppointers[i] - m_offset);
+		const int* pi = m_pindices + (m_ppointers[i] - m_offset);
+		const int n = m_ppointers[i + 1] - m_ppointers[i];
+		r[i] = 0.0;
+		for (int j = 0; j < n; j ++)
 		{
-			const double* pv = m_pd + (m_ppointers[i] - m_offset);
-			const int* pi = m_pindices + (m_ppointers[i] - m_offset);
-			const int n = m_ppointers[i + 1] - m_ppointers[i];
-			r[i] = 0.0;
-			for (int j = 0; j < n; j ++)
-			{
-				r[i] += (*pv++) * x[*pi++ - m_offset];
-			}
+			r[i] += (*pv++) * x[*pi++ - m_offset];
 		}
 	}
 
 	return true;
-#else
-	return false;
-#endif
 }
 
 //! calculate the abs row sum 
@@ -629,7 +651,8 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This must be a local array since this function can be called concurrently.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -657,8 +680,12 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += ke[i][j];
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -685,6 +712,24 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const v
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! calculate the assembly map of an element matrix
+bool CCSSparseMatrix::AssemblyMap(int nr, int nc, const vector<int>& LMi, const vector<int>& LMj, vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = LMi[i];
+		if (I < 0) continue;
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = LMj[j];
+			if (J >= 0) map[i*nc + j] = findOffset(J, I);
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // This algorithm uses a binary search for locating the correct row index
 // This assumes that the indices are ordered!
@@ -704,8 +749,12 @@ void CCSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == i)
 		{
+			if (m_batomic)
+			{
 #pragma omp atomic
-			pd[n] += v;
+				pd[n] += v;
+			}
+			else pd[n] += v;
 			return;
 		}
 		else if (m < i)
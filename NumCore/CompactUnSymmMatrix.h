@@ -72,6 +72,9 @@ public:
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const vector<int>& lmi, const vector<int>& lmj, vector<int>& map) override;
+
 	//! add a value to the matrix item
 	void add(int i, int j, double v) override;
 
@@ -143,6 +146,9 @@ public:
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const vector<int>& lmi, const vector<int>& lmj, vector<int>& map) override;
+
 	//! add a value to the matrix item
 	void add(int i, int j, double v) override;
 
@@ -52,6 +52,7 @@ BEGIN_FECORE_CLASS(FGMRESSolver, IterativeLinearSolver)
 	ADD_PARAMETER(m_reltol        , "tol");
 	ADD_PARAMETER(m_abstol        , "abs_tol");
 	ADD_PARAMETER(m_maxIterFail   , "fail_max_iters");
+	ADD_PARAMETER(m_bparMult      , "parallel_mult");
 
 	ADD_PROPERTY(m_P, "pc_left");
 	ADD_PROPERTY(m_R, "pc_right");
@@ -68,6 +69,7 @@ FGMRESSolver::FGMRESSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(0)
 	m_abstol = 0.0;
 	m_nrestart = 0; // use default = maxiter
 	m_print_cn = false;
+	m_bparMult = true;
 
 	m_do_jacobi = false;
 
@@ -247,6 +249,10 @@ void FGMRESSolver::Destroy()
 //-----------------------------------------------------------------------------
 bool FGMRESSolver::PreProcess() 
 {
+	// use the multithreaded matrix-vector product for symmetric matrices
+	CompactSymmMatrix* K = dynamic_cast<CompactSymmMatrix*>(m_pA);
+	if (K) K->UseParallelMultiply(m_bparMult);
+
 #ifdef MKL_ISS
 	// number of equations
 	MKL_INT N = m_pA->Rows();
@@ -116,6 +116,7 @@ private:
 	bool	m_maxIterFail;
 	bool	m_print_cn;			// Calculate and print the condition number
 	bool	m_do_jacobi;
+	bool	m_bparMult;			// use multithreaded matrix-vector product
 
 private:
 	SparseMatrix*	m_pA;		//!< the sparse matrix format
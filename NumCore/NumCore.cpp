@@ -26,6 +26,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "NumCore.h"
 #include "SkylineSolver.h"
+#include "SupernodalSolver.h"
 #include "LUSolver.h"
 #include "PardisoSolver.h"
 #include "RCICGSolver.h"
@@ -40,6 +41,7 @@ SOFTWARE.*/
 #include "BoomerAMGSolver.h"
 #include "BlockSolver.h"
 #include "BiCGStabSolver.h"
+#include "AMG_Preconditioner.h"
 #include "StrategySolver.h"
 #include <FECore/fecore_enum.h>
 #include <FECore/FECoreFactory.h>
@@ -54,6 +56,7 @@ void NumCore::InitModule()
 	REGISTER_FECORE_CLASS(PardisoSolver  , "pardiso");
 	REGISTER_FECORE_CLASS(SkylineSolver  , "skyline");
 	REGISTER_FECORE_CLASS(LUSolver       , "LU"     );
+	REGISTER_FECORE_CLASS(SupernodalSolver, "supernodal");
 	REGISTER_FECORE_CLASS(FGMRESSolver        , "fgmres"   );
 	REGISTER_FECORE_CLASS(BoomerAMGSolver     , "boomeramg");
 	REGISTER_FECORE_CLASS(RCICGSolver         , "cg"    );
@@ -69,6 +72,7 @@ void NumCore::InitModule()
 	REGISTER_FECORE_CLASS(ILU0_Preconditioner, "ilu0");
 	REGISTER_FECORE_CLASS(ILUT_Preconditioner, "ilut");
 	REGISTER_FECORE_CLASS(IncompleteCholesky , "ichol");
+	REGISTER_FECORE_CLASS(AMG_Preconditioner , "amg");
 
 	// register eigen solvers
 	REGISTER_FECORE_CLASS(FEASTEigenSolver, "feast");
@@ -99,6 +99,7 @@ PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
 	m_mtype = -2;
 	m_iparm3 = false;
 	m_isFactored = false;
+	m_isAnalyzed = false;
 
 	/* If both PARDISO AND PARDISODL are defined, print a warning */
 #ifdef PARDISODL
@@ -163,6 +164,7 @@ bool PardisoSolver::PreProcess()
 	//fprintf(stderr, "In PreProcess\n");
 	assert(m_isFactored == false);
 	pardisoinit(m_pt, &m_mtype, m_iparm);
+	m_isAnalyzed = false;
 
 	m_n = m_pA->Rows();
 	m_nnz = m_pA->NonZeroes();
@@ -189,19 +191,27 @@ bool PardisoSolver::Factor()
 // ------------------------------------------------------------------------------
 // Reordering and Symbolic Factorization.  This step also allocates all memory
 // that is necessary for the factorization.
+// The symbolic factorization only depends on the sparsity pattern, so it is 
+// reused until the matrix structure changes (i.e. until PreProcess is called again).
+// For unsymmetric matrices the analysis also computes the scaling and matching 
+// from the matrix values, so we always redo it in that case.
 // ------------------------------------------------------------------------------
 
 	int phase = 11;
 
 	int error = 0;
-	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
-		 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
-
-	if (error)
+	if ((m_isAnalyzed == false) || (m_mtype != -2))
 	{
-		fprintf(stderr, "\nERROR during symbolic factorization: ");
-		print_err(error);
-		exit(2);
+		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
+			 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
+
+		if (error)
+		{
+			fprintf(stderr, "\nERROR during symbolic factorization: ");
+			print_err(error);
+			exit(2);
+		}
+		m_isAnalyzed = true;
 	}
 
 // ------------------------------------------------------------------------------
@@ -318,6 +328,7 @@ void PardisoSolver::Destroy()
 			NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
 	}
 	m_isFactored = false;
+	m_isAnalyzed = false;
 }
 #else 
 BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
@@ -47,6 +47,7 @@ BEGIN_FECORE_CLASS(RCICGSolver, IterativeLinearSolver)
 	ADD_PARAMETER(m_tol, "tol");
 	ADD_PARAMETER(m_maxiter, "max_iter");
 	ADD_PARAMETER(m_fail_max_iters, "fail_max_iters");
+	ADD_PARAMETER(m_bparMult, "parallel_mult");
 	ADD_PROPERTY(m_P, "pc_left");
 END_FECORE_CLASS();
 
@@ -57,6 +58,7 @@ RCICGSolver::RCICGSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(0), m_
 	m_tol = 1e-5;
 	m_print_level = 0;
 	m_fail_max_iters = true;
+	m_bparMult = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -64,7 +66,20 @@ SparseMatrix* RCICGSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
 #ifdef MKL_ISS
 	if (ntype != REAL_SYMMETRIC) return 0;
-	m_pA = new CompactSymmMatrix(1);
+
+	// see if the preconditioner wants to allocate the matrix
+	m_pA = nullptr;
+	if (m_P)
+	{
+		m_P->SetPartitions(m_part);
+		m_pA = m_P->CreateSparseMatrix(ntype);
+	}
+
+	if (m_pA == nullptr)
+	{
+		m_pA = new CompactSymmMatrix(1);
+		if (m_P) m_P->SetSparseMatrix(m_pA);
+	}
 	return m_pA;
 #else
 	return 0;
@@ -99,6 +114,10 @@ bool RCICGSolver::HasPreconditioner() const
 //-----------------------------------------------------------------------------
 bool RCICGSolver::PreProcess()
 {
+	// use the multithreaded matrix-vector product for symmetric matrices
+	CompactSymmMatrix* K = dynamic_cast<CompactSymmMatrix*>(m_pA);
+	if (K) K->UseParallelMultiply(m_bparMult);
+
 	return true;
 }
 
@@ -106,6 +125,14 @@ bool RCICGSolver::PreProcess()
 bool RCICGSolver::Factor()
 {
 	if (m_pA == 0) return false;
+
+	// call the preconditioner
+	if (m_P)
+	{
+		if (m_P->PreProcess() == false) return false;
+		if (m_P->Factor() == false) return false;
+	}
+
 	return true;
 }
 
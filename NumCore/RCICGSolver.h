@@ -59,6 +59,7 @@ protected:
 	double	m_tol;			// residual relative tolerance
 	int		m_print_level;	// output level
 	bool	m_fail_max_iters;
+	bool	m_bparMult;		// use multithreaded matrix-vector product
 
 	DECLARE_FECORE_CLASS();
 };
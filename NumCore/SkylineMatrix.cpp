@@ -124,8 +124,12 @@ void SkylineMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 				// only add values to upper-diagonal part of stiffness matrix
 				if (J>=I)
 				{
-					#pragma omp atomic
-					pv[ pi[J] + J - I] += ke[i][j];
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pv[ pi[J] + J - I] += ke[i][j];
+					}
+					else pv[ pi[J] + J - I] += ke[i][j];
 				}
 			}
 		}
@@ -156,15 +160,65 @@ void SkylineMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const vec
 
 				// only add values to upper-diagonal part of stiffness matrix
 				if (J>=I)
+				{
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pv[ pi[J] + J - I] += ke[i][j];
+					}
+					else pv[ pi[J] + J - I] += ke[i][j];
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! calculate the assembly map of an element matrix (only the upper-triangular part is stored)
+bool SkylineMatrix::AssemblyMap(int nr, int nc, const vector<int>& LMi, const vector<int>& LMj, vector<int>& map)
+{
+	int* pi = pointers();
+	map.assign(nr*nc, -1);
+	for (int i=0; i<nr; ++i)
+	{
+		int I = LMi[i];
+		if (I < 0) continue;
+		for (int j=0; j<nc; ++j)
+		{
+			int J = LMj[j];
+			if (J >= I) map[i*nc + j] = pi[J] + J - I;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! assemble a matrix using a precomputed assembly map
+void SkylineMatrix::AssembleMapped(const matrix& ke, const vector<int>& map)
+{
+	const int N = ke.rows();
+	const int M = ke.columns();
+	double* pv = values();
+	const int* pm = &map[0];
+	for (int i=0; i<N; ++i, pm += M)
+	{
+		for (int j=0; j<M; ++j)
+		{
+			int n = pm[j];
+			if (n >= 0)
+			{
+				if (m_batomic)
 				{
 					#pragma omp atomic
-					pv[ pi[J] + J - I] += ke[i][j];
+					pv[n] += ke[i][j];
 				}
+				else pv[n] += ke[i][j];
 			}
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
 bool SkylineMatrix::check(int i, int j)
 {
 	assert(false);
@@ -176,8 +230,12 @@ void SkylineMatrix::add(int i, int j, double v)
 	// only add to the upper triangular part
 	if (j >= i)
 	{
-		#pragma omp atomic
-		m_pd[m_ppointers[j] + j - i] += v;
+		if (m_batomic)
+		{
+			#pragma omp atomic
+			m_pd[m_ppointers[j] + j - i] += v;
+		}
+		else m_pd[m_ppointers[j] + j - i] += v;
 	}
 }
 
@@ -54,6 +54,12 @@ public: // from SparseMatrix
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! calculate the assembly map of an element matrix
+	bool AssemblyMap(int nr, int nc, const vector<int>& lmi, const vector<int>& lmj, vector<int>& map) override;
+
+	//! assemble a matrix using a precomputed assembly map
+	void AssembleMapped(const matrix& ke, const vector<int>& map) override;
+
 	void add(int i, int j, double v) override;
 
 	void set(int i, int j, double v) override;
@@ -0,0 +1,795 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "SupernodalSolver.h"
+#include <FECore/log.h>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// subgraphs smaller than this are not dissected any further
+#define ND_MIN_SIZE	128
+
+// block size used in the dense partial factorization of the frontal matrices
+#define FRONT_BLOCK_SIZE	64
+
+//-----------------------------------------------------------------------------
+// Apply the updates of the columns k0..k1-1 of L to the columns j0..j1-1 of the
+// frontal matrix F, i.e. F(i,j) -= L(i,k)*D(k)*L(j,k) for i >= j. Both F and L
+// are stored column major with leading dimension m. Four columns are updated
+// at once so that each column of L is only read once for every four columns.
+static void update_columns(double* F, int m, int j0, int j1, const double* L, const double* D, int k0, int k1)
+{
+	int j = j0;
+	for (; j + 3 < j1; j += 4)
+	{
+		double* F0 = F + (size_t)j*m;
+		double* F1 = F0 + m;
+		double* F2 = F1 + m;
+		double* F3 = F2 + m;
+		for (int k = k0; k < k1; ++k)
+		{
+			const double* Lk = L + (size_t)k*m;
+			double w0 = Lk[j    ] * D[k];
+			double w1 = Lk[j + 1] * D[k];
+			double w2 = Lk[j + 2] * D[k];
+			double w3 = Lk[j + 3] * D[k];
+
+			// the upper triangle of this block of columns
+			F0[j] -= Lk[j] * w0;
+			F0[j + 1] -= Lk[j + 1] * w0; F1[j + 1] -= Lk[j + 1] * w1;
+			F0[j + 2] -= Lk[j + 2] * w0; F1[j + 2] -= Lk[j + 2] * w1; F2[j + 2] -= Lk[j + 2] * w2;
+
+			for (int i = j + 3; i < m; ++i)
+			{
+				double l = Lk[i];
+				F0[i] -= l * w0;
+				F1[i] -= l * w1;
+				F2[i] -= l * w2;
+				F3[i] -= l * w3;
+			}
+		}
+	}
+
+	// remaining columns
+	for (; j < j1; ++j)
+	{
+		double* Fj = F + (size_t)j*m;
+		for (int k = k0; k < k1; ++k)
+		{
+			const double* Lk = L + (size_t)k*m;
+			double w = Lk[j] * D[k];
+			for (int i = j; i < m; ++i) Fj[i] -= Lk[i] * w;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::SupernodalSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
+{
+	m_neq = 0;
+	m_nsuper = 0;
+	m_bfail = false;
+}
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::~SupernodalSolver()
+{
+	Destroy();
+}
+
+//-----------------------------------------------------------------------------
+//! Create a sparse matrix
+SparseMatrix* SupernodalSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	return (m_pA = (ntype == REAL_SYMMETRIC ? new CompactSymmMatrix(0) : 0));
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_pA = dynamic_cast<CompactSymmMatrix*>(pA);
+	return (m_pA != 0);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the ordering and the symbolic factorization. This only depends
+//! on the sparsity pattern of the matrix.
+bool SupernodalSolver::PreProcess()
+{
+	if (m_pA == 0) return false;
+	m_neq = m_pA->Rows();
+	const int N = m_neq;
+
+	// build the adjacency graph of the matrix
+	const int* pp = m_pA->Pointers();
+	const int* pi = m_pA->Indices();
+	const int off = m_pA->Offset();
+	vector<int> xadj(N + 1, 0);
+	for (int j = 0; j < N; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int i = pi[k] - off;
+			if (i != j) { xadj[i + 1]++; xadj[j + 1]++; }
+		}
+	}
+	for (int i = 0; i < N; ++i) xadj[i + 1] += xadj[i];
+	vector<int> adj(xadj[N]);
+	vector<int> pos(xadj.begin(), xadj.end() - 1);
+	for (int j = 0; j < N; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int i = pi[k] - off;
+			if (i != j) { adj[pos[i]++] = j; adj[pos[j]++] = i; }
+		}
+	}
+
+	// calculate the fill-reducing ordering
+	NestedDissection(xadj, adj);
+
+	// do the symbolic factorization
+	return SymbolicFactor();
+}
+
+//-----------------------------------------------------------------------------
+// Calculate a nested dissection ordering. Subgraphs are split with a vertex 
+// separator that is taken from a level structure rooted at a pseudo-peripheral 
+// vertex. Separators are numbered last, so they are eliminated last.
+void SupernodalSolver::NestedDissection(const vector<int>& xadj, const vector<int>& adj)
+{
+	const int N = m_neq;
+	m_perm.assign(N, -1);
+	m_iperm.assign(N, -1);
+	if (N == 0) return;
+
+	vector<int> part(N, 0);		// subgraph each vertex belongs to (-1 = numbered)
+	vector<int> level(N, -1);	// level of vertex in the level structure
+	vector<int> queue(N);
+	int nextPart = 1;
+	int next = N - 1;
+
+	// breadth-first search from root, restricted to subgraph pid
+	// The visited vertices are added to the queue, starting at position start.
+	auto bfs = [&](int root, int pid, int start, int& nlevels) {
+		int head = start, tail = start;
+		queue[tail++] = root; level[root] = 0; nlevels = 1;
+		while (head < tail)
+		{
+			int v = queue[head++];
+			for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+			{
+				int w = adj[k];
+				if ((part[w] == pid) && (level[w] < 0))
+				{
+					level[w] = level[v] + 1;
+					if (level[w] + 1 > nlevels) nlevels = level[w] + 1;
+					queue[tail++] = w;
+				}
+			}
+		}
+		return tail;
+	};
+
+	auto clearLevels = [&](int n) { for (int i = 0; i < n; ++i) level[queue[i]] = -1; };
+
+	vector< vector<int> > stack(1);
+	stack[0].resize(N);
+	for (int i = 0; i < N; ++i) stack[0][i] = i;
+
+	while (stack.empty() == false)
+	{
+		vector<int> nodes;
+		nodes.swap(stack.back());
+		stack.pop_back();
+		const int nn = (int)nodes.size();
+		const int pid = part[nodes[0]];
+
+		// small subgraphs are numbered directly
+		if (nn <= ND_MIN_SIZE)
+		{
+			for (int i = nn - 1; i >= 0; --i) { m_perm[next--] = nodes[i]; part[nodes[i]] = -1; }
+			continue;
+		}
+
+		// see if the subgraph is connected
+		int nlevels = 0;
+		int nreach = bfs(nodes[0], pid, 0, nlevels);
+		if (nreach < nn)
+		{
+			// split the subgraph in its connected components
+			int n0 = 0;
+			int n1 = nreach;
+			for (int i = 0; ; ++i)
+			{
+				vector<int> comp(queue.begin() + n0, queue.begin() + n1);
+				stack.push_back(comp);
+
+				while ((i < nn) && (level[nodes[i]] >= 0)) ++i;
+				if (i >= nn) break;
+				n0 = n1;
+				n1 = bfs(nodes[i], pid, n0, nlevels);
+			}
+			clearLevels(n1);
+			for (size_t k = 0; k < stack.size(); ++k)
+			{
+				vector<int>& comp = stack[k];
+				if (part[comp[0]] == pid)
+				{
+					int newPart = nextPart++;
+					for (size_t l = 0; l < comp.size(); ++l) part[comp[l]] = newPart;
+				}
+			}
+			continue;
+		}
+
+		// find a pseudo-peripheral vertex
+		for (int iter = 0; iter < 5; ++iter)
+		{
+			// pick the vertex with the smallest degree in the last level
+			int root = -1, mindeg = 0;
+			for (int i = nreach - 1; (i >= 0) && (level[queue[i]] == nlevels - 1); --i)
+			{
+				int v = queue[i];
+				int deg = xadj[v + 1] - xadj[v];
+				if ((root == -1) || (deg < mindeg)) { root = v; mindeg = deg; }
+			}
+
+			int nl = nlevels;
+			clearLevels(nreach);
+			nreach = bfs(root, pid, 0, nlevels);
+			if (nlevels <= nl) break;
+		}
+
+		// we need at least three levels to find a separator
+		if (nlevels < 3)
+		{
+			clearLevels(nreach);
+			for (int i = nreach - 1; i >= 0; --i) { m_perm[next--] = queue[i]; part[queue[i]] = -1; }
+			continue;
+		}
+
+		// find the level that splits the subgraph in two halves
+		int nsep = 1;
+		for (int i = 0; i < nreach; ++i)
+		{
+			int v = queue[i];
+			if (2 * (i + 1) >= nreach) { nsep = level[v]; break; }
+		}
+		if (nsep < 1) nsep = 1;
+		if (nsep > nlevels - 2) nsep = nlevels - 2;
+
+		// The separator consists of the vertices in this level that are connected to the next level.
+		// The remaining vertices in this level are added to the lower half.
+		int lowerPart = nextPart++;
+		int upperPart = nextPart++;
+		vector<int> lower, upper, sep;
+		for (int i = 0; i < nreach; ++i)
+		{
+			int v = queue[i];
+			int l = level[v];
+			if (l < nsep) lower.push_back(v);
+			else if (l > nsep) upper.push_back(v);
+			else
+			{
+				bool bsep = false;
+				for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+				{
+					int w = adj[k];
+					if ((part[w] == pid) && (level[w] == nsep + 1)) { bsep = true; break; }
+				}
+				if (bsep) sep.push_back(v); else lower.push_back(v);
+			}
+		}
+		clearLevels(nreach);
+
+		// number the separator
+		for (int i = (int)sep.size() - 1; i >= 0; --i) { m_perm[next--] = sep[i]; part[sep[i]] = -1; }
+
+		// process the two halves
+		for (size_t i = 0; i < lower.size(); ++i) part[lower[i]] = lowerPart;
+		for (size_t i = 0; i < upper.size(); ++i) part[upper[i]] = upperPart;
+		if (lower.empty() == false) stack.push_back(lower);
+		if (upper.empty() == false) stack.push_back(upper);
+	}
+	assert(next == -1);
+
+	for (int i = 0; i < N; ++i) m_iperm[m_perm[i]] = i;
+}
+
+//-----------------------------------------------------------------------------
+// Build the lower-triangular part of the permuted matrix C = P*A*P^T in 
+// compressed column format, and the map from the values of A to C.
+void SupernodalSolver::BuildPermutedMatrix()
+{
+	const int N = m_neq;
+	const int* pp = m_pA->Pointers();
+	const int* pi = m_pA->Indices();
+	const int off = m_pA->Offset();
+	const int nnz = m_pA->NonZeroes();
+
+	m_Cp.assign(N + 1, 0);
+	for (int j = 0; j < N; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int a = m_iperm[pi[k] - off];
+			int b = m_iperm[j];
+			m_Cp[(a < b ? a : b) + 1]++;
+		}
+	}
+	for (int i = 0; i < N; ++i) m_Cp[i + 1] += m_Cp[i];
+
+	m_Ci.resize(nnz);
+	m_Amap.resize(nnz);
+	m_Cx.resize(nnz);
+	vector<int> pos(m_Cp.begin(), m_Cp.end() - 1);
+	for (int j = 0; j < N; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int a = m_iperm[pi[k] - off];
+			int b = m_iperm[j];
+			int r = (a > b ? a : b);
+			int c = (a < b ? a : b);
+			int q = pos[c]++;
+			m_Ci[q] = r;
+			m_Amap[k] = q;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the elimination tree of the permuted matrix (Liu's algorithm)
+void SupernodalSolver::EliminationTree(vector<int>& parent)
+{
+	const int N = m_neq;
+	parent.assign(N, -1);
+	vector<int> ancestor(N, -1);
+
+	// we need the row structure of the (strictly) lower triangular part
+	vector<int> Rp(N + 1, 0);
+	for (int c = 0; c < N; ++c)
+		for (int q = m_Cp[c]; q < m_Cp[c + 1]; ++q) if (m_Ci[q] > c) Rp[m_Ci[q] + 1]++;
+	for (int i = 0; i < N; ++i) Rp[i + 1] += Rp[i];
+	vector<int> Ri(Rp[N]);
+	vector<int> pos(Rp.begin(), Rp.end() - 1);
+	for (int c = 0; c < N; ++c)
+		for (int q = m_Cp[c]; q < m_Cp[c + 1]; ++q) if (m_Ci[q] > c) Ri[pos[m_Ci[q]]++] = c;
+
+	for (int k = 0; k < N; ++k)
+	{
+		for (int q = Rp[k]; q < Rp[k + 1]; ++q)
+		{
+			int i = Ri[q];
+			while ((i != -1) && (i < k))
+			{
+				int inext = ancestor[i];
+				ancestor[i] = k;
+				if (inext == -1) parent[i] = k;
+				i = inext;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The symbolic factorization calculates the structure of the factor. 
+bool SupernodalSolver::SymbolicFactor()
+{
+	const int N = m_neq;
+
+	// build the permuted matrix and its elimination tree
+	BuildPermutedMatrix();
+	vector<int> parent;
+	EliminationTree(parent);
+
+	// Postorder the elimination tree. This does not change the fill, but makes
+	// sure that the columns of each supernode are numbered consecutively.
+	vector<int> head(N, -1), nextSibling(N, -1);
+	for (int j = N - 1; j >= 0; --j)
+	{
+		if (parent[j] != -1) { nextSibling[j] = head[parent[j]]; head[parent[j]] = j; }
+	}
+	vector<int> post(N), stack;
+	int k = 0;
+	for (int j = 0; j < N; ++j)
+	{
+		if (parent[j] != -1) continue;
+		stack.push_back(j);
+		while (stack.empty() == false)
+		{
+			int p = stack.back();
+			int c = head[p];
+			if (c == -1) { stack.pop_back(); post[k++] = p; }
+			else { head[p] = nextSibling[c]; stack.push_back(c); }
+		}
+	}
+	assert(k == N);
+
+	vector<int> perm(N);
+	for (int i = 0; i < N; ++i) perm[i] = m_perm[post[i]];
+	m_perm = perm;
+	for (int i = 0; i < N; ++i) m_iperm[m_perm[i]] = i;
+
+	// rebuild the permuted matrix and elimination tree with the new ordering
+	BuildPermutedMatrix();
+	EliminationTree(parent);
+
+	// calculate the column counts of L by traversing the row subtrees
+	vector<int> colCount(N, 1), mark(N, -1);
+	{
+		vector<int> Rp(N + 1, 0);
+		for (int c = 0; c < N; ++c)
+			for (int q = m_Cp[c]; q < m_Cp[c + 1]; ++q) if (m_Ci[q] > c) Rp[m_Ci[q] + 1]++;
+		for (int i = 0; i < N; ++i) Rp[i + 1] += Rp[i];
+		vector<int> Ri(Rp[N]);
+		vector<int> pos(Rp.begin(), Rp.end() - 1);
+		for (int c = 0; c < N; ++c)
+			for (int q = m_Cp[c]; q < m_Cp[c + 1]; ++q) if (m_Ci[q] > c) Ri[pos[m_Ci[q]]++] = c;
+
+		for (int r = 0; r < N; ++r)
+		{
+			mark[r] = r;
+			for (int q = Rp[r]; q < Rp[r + 1]; ++q)
+			{
+				for (int i = Ri[q]; mark[i] != r; i = parent[i])
+				{
+					colCount[i]++;
+					mark[i] = r;
+				}
+			}
+		}
+	}
+
+	// find the fundamental supernodes
+	vector<int> nchild(N, 0);
+	for (int j = 0; j < N; ++j) if (parent[j] != -1) nchild[parent[j]]++;
+
+	m_sfirst.clear();
+	vector<int> snode(N);
+	for (int j = 0; j < N; ++j)
+	{
+		if ((j == 0) || (parent[j - 1] != j) || (colCount[j - 1] != colCount[j] + 1) || (nchild[j] != 1))
+			m_sfirst.push_back(j);
+		snode[j] = (int)m_sfirst.size() - 1;
+	}
+	m_nsuper = (int)m_sfirst.size();
+	m_sfirst.push_back(N);
+
+	// the assembly tree
+	m_sparent.assign(m_nsuper, -1);
+	for (int s = 0; s < m_nsuper; ++s)
+	{
+		int l = m_sfirst[s + 1] - 1;
+		if (parent[l] != -1) m_sparent[s] = snode[parent[l]];
+	}
+
+	m_schildp.assign(m_nsuper + 1, 0);
+	for (int s = 0; s < m_nsuper; ++s) if (m_sparent[s] != -1) m_schildp[m_sparent[s] + 1]++;
+	for (int s = 0; s < m_nsuper; ++s) m_schildp[s + 1] += m_schildp[s];
+	m_schild.resize(m_schildp[m_nsuper]);
+	vector<int> pos(m_schildp.begin(), m_schildp.end() - 1);
+	for (int s = 0; s < m_nsuper; ++s) if (m_sparent[s] != -1) m_schild[pos[m_sparent[s]]++] = s;
+
+	// calculate the row structure of each supernode. This is the union of the 
+	// structure of the matrix columns and the children's row structures.
+	m_srowp.assign(m_nsuper + 1, 0);
+	for (int s = 0; s < m_nsuper; ++s) m_srowp[s + 1] = m_srowp[s] + colCount[m_sfirst[s]];
+	m_srow.resize(m_srowp[m_nsuper]);
+	mark.assign(N, -1);
+	for (int s = 0; s < m_nsuper; ++s)
+	{
+		int f = m_sfirst[s];
+		int l = m_sfirst[s + 1] - 1;
+		int* R = &m_srow[0] + m_srowp[s];
+		int m = 0;
+		for (int j = f; j <= l; ++j) { R[m++] = j; mark[j] = s; }
+
+		for (int j = f; j <= l; ++j)
+		{
+			for (int q = m_Cp[j]; q < m_Cp[j + 1]; ++q)
+			{
+				int r = m_Ci[q];
+				if (mark[r] != s) { R[m++] = r; mark[r] = s; }
+			}
+		}
+
+		for (int i = m_schildp[s]; i < m_schildp[s + 1]; ++i)
+		{
+			int c = m_schild[i];
+			for (int q = m_srowp[c]; q < m_srowp[c + 1]; ++q)
+			{
+				int r = m_srow[q];
+				if ((r > l) && (mark[r] != s)) { R[m++] = r; mark[r] = s; }
+			}
+		}
+
+		if (m != m_srowp[s + 1] - m_srowp[s])
+		{
+			feLogError("Symbolic factorization failed in supernodal solver.");
+			return false;
+		}
+		std::sort(R + (l - f + 1), R + m);
+	}
+
+	// sort the supernodes by their level in the assembly tree, so that all 
+	// supernodes of the same level can be processed in parallel
+	vector<int> lev(m_nsuper, 0);
+	int nlevels = 0;
+	for (int s = 0; s < m_nsuper; ++s)
+	{
+		int p = m_sparent[s];
+		if ((p != -1) && (lev[p] < lev[s] + 1)) lev[p] = lev[s] + 1;
+		if (lev[s] + 1 > nlevels) nlevels = lev[s] + 1;
+	}
+	m_levelp.assign(nlevels + 1, 0);
+	for (int s = 0; s < m_nsuper; ++s) m_levelp[lev[s] + 1]++;
+	for (int i = 0; i < nlevels; ++i) m_levelp[i + 1] += m_levelp[i];
+	m_level.resize(m_nsuper);
+	pos.assign(m_levelp.begin(), m_levelp.end() - 1);
+	for (int s = 0; s < m_nsuper; ++s) m_level[pos[lev[s]]++] = s;
+
+	// allocate storage for the factor
+	m_Lp.resize(m_nsuper + 1);
+	m_Lp[0] = 0;
+	for (int s = 0; s < m_nsuper; ++s)
+	{
+		size_t ns = m_sfirst[s + 1] - m_sfirst[s];
+		size_t m = m_srowp[s + 1] - m_srowp[s];
+		m_Lp[s + 1] = m_Lp[s] + m*ns;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::Factor()
+{
+	if ((m_pA == 0) || (m_neq != m_pA->Rows())) return false;
+	const int N = m_neq;
+
+	// copy the matrix values to the permuted matrix
+	const double* pv = m_pA->Values();
+	const int nnz = m_pA->NonZeroes();
+	for (int k = 0; k < nnz; ++k) m_Cx[m_Amap[k]] = pv[k];
+
+	m_Lx.resize(m_Lp[m_nsuper]);
+	m_D.resize(N);
+	m_U.assign(m_nsuper, vector<double>());
+	m_bfail = false;
+
+	int nthreads = 1;
+#ifdef _OPENMP
+	nthreads = omp_get_max_threads();
+#endif
+	m_relpos.resize(nthreads);
+	for (int i = 0; i < nthreads; ++i) m_relpos[i].resize(N);
+
+	// process the assembly tree level by level
+	const int nlevels = (int)m_levelp.size() - 1;
+	for (int l = 0; l < nlevels; ++l)
+	{
+		const int n0 = m_levelp[l];
+		const int n1 = m_levelp[l + 1];
+		if ((nthreads > 1) && (n1 - n0 >= nthreads))
+		{
+			// factor the supernodes in this level in parallel
+			#pragma omp parallel for schedule(dynamic)
+			for (int i = n0; i < n1; ++i)
+			{
+				int tid = 0;
+#ifdef _OPENMP
+				tid = omp_get_thread_num();
+#endif
+				FactorSupernode(m_level[i], m_relpos[tid], false);
+			}
+		}
+		else
+		{
+			// only a few supernodes, so parallelize the dense updates instead
+			for (int i = n0; i < n1; ++i) FactorSupernode(m_level[i], m_relpos[0], true);
+		}
+
+		if (m_bfail)
+		{
+			feLogError("Zero pivot encountered in supernodal solver.");
+			return false;
+		}
+	}
+
+	m_U.clear();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Factor a supernode using the multifrontal method. The frontal matrix is 
+// assembled from the matrix columns and the children's update matrices. Then
+// the supernode's columns are factored and the update matrix is calculated.
+void SupernodalSolver::FactorSupernode(int s, vector<int>& relpos, bool parallel)
+{
+	if (m_bfail) return;
+
+	const int f = m_sfirst[s];
+	const int ns = m_sfirst[s + 1] - f;
+	const int m = m_srowp[s + 1] - m_srowp[s];
+	const int* R = &m_srow[0] + m_srowp[s];
+	for (int i = 0; i < m; ++i) relpos[R[i]] = i;
+
+	// the frontal matrix (lower triangular part, column major)
+	vector<double> F((size_t)m*m, 0.0);
+
+	// assemble the matrix entries
+	for (int k = 0; k < ns; ++k)
+	{
+		double* Fk = &F[0] + (size_t)k*m;
+		int j = f + k;
+		for (int q = m_Cp[j]; q < m_Cp[j + 1]; ++q) Fk[relpos[m_Ci[q]]] += m_Cx[q];
+	}
+
+	// extend-add the children's update matrices
+	for (int n = m_schildp[s]; n < m_schildp[s + 1]; ++n)
+	{
+		int c = m_schild[n];
+		int nc = m_sfirst[c + 1] - m_sfirst[c];
+		int mu = m_srowp[c + 1] - m_srowp[c] - nc;
+		const int* Rc = &m_srow[0] + m_srowp[c] + nc;
+		vector<double>& U = m_U[c];
+		for (int b = 0; b < mu; ++b)
+		{
+			double* Fb = &F[0] + (size_t)relpos[Rc[b]]*m;
+			const double* Ub = &U[0] + (size_t)b*mu;
+			for (int a = b; a < mu; ++a) Fb[relpos[Rc[a]]] += Ub[a];
+		}
+		vector<double>().swap(U);
+	}
+
+	// partial (blocked) LDL^T factorization of the first ns columns
+	double* D = &m_D[f];
+	for (int k0 = 0; k0 < ns; k0 += FRONT_BLOCK_SIZE)
+	{
+		int k1 = (k0 + FRONT_BLOCK_SIZE < ns ? k0 + FRONT_BLOCK_SIZE : ns);
+
+		// factor the columns of this block
+		for (int k = k0; k < k1; ++k)
+		{
+			double* Fk = &F[0] + (size_t)k*m;
+			double d = Fk[k];
+			if (d == 0.0) { m_bfail = true; return; }
+			D[k] = d;
+			for (int i = k + 1; i < m; ++i) Fk[i] /= d;
+
+			for (int j = k + 1; j < k1; ++j)
+			{
+				double w = Fk[j] * d;
+				double* Fj = &F[0] + (size_t)j*m;
+				for (int i = j; i < m; ++i) Fj[i] -= Fk[i] * w;
+			}
+		}
+
+		// update the remaining columns of the supernode
+		const int nb = (ns - k1 + 3) / 4;
+		#pragma omp parallel for schedule(dynamic) if (parallel && (ns - k1 > FRONT_BLOCK_SIZE))
+		for (int b = 0; b < nb; ++b)
+		{
+			int j0 = k1 + 4 * b;
+			int j1 = (j0 + 4 < ns ? j0 + 4 : ns);
+			update_columns(&F[0], m, j0, j1, &F[0], D, k0, k1);
+		}
+	}
+
+	// store the factored columns
+	double* L = &m_Lx[0] + m_Lp[s];
+	for (size_t i = 0; i < (size_t)m*ns; ++i) L[i] = F[i];
+
+	// calculate the update matrix for the parent
+	const int mu = m - ns;
+	if (mu > 0)
+	{
+		vector<double>& U = m_U[s];
+		U.assign((size_t)mu*mu, 0.0);
+
+		const int nb = (mu + 3) / 4;
+		#pragma omp parallel for schedule(dynamic) if (parallel && (mu > FRONT_BLOCK_SIZE))
+		for (int b = 0; b < nb; ++b)
+		{
+			int j0 = ns + 4 * b;
+			int j1 = (j0 + 4 < m ? j0 + 4 : m);
+			update_columns(&F[0], m, j0, j1, L, D, 0, ns);
+
+			for (int j = j0; j < j1; ++j)
+			{
+				const double* Fj = &F[0] + (size_t)j*m;
+				double* Uj = &U[0] + (size_t)(j - ns)*mu;
+				for (int a = j - ns; a < mu; ++a) Uj[a] = Fj[ns + a];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::BackSolve(double* x, double* b)
+{
+	const int N = m_neq;
+	vector<double> y(N);
+	for (int i = 0; i < N; ++i) y[i] = b[m_perm[i]];
+
+	// forward substitution L*z = y
+	for (int s = 0; s < m_nsuper; ++s)
+	{
+		const int f = m_sfirst[s];
+		const int ns = m_sfirst[s + 1] - f;
+		const int m = m_srowp[s + 1] - m_srowp[s];
+		const int* R = &m_srow[0] + m_srowp[s];
+		const double* L = &m_Lx[0] + m_Lp[s];
+		for (int k = 0; k < ns; ++k)
+		{
+			const double* Lk = L + (size_t)k*m;
+			double yk = y[f + k];
+			for (int i = k + 1; i < m; ++i) y[R[i]] -= Lk[i] * yk;
+		}
+	}
+
+	// diagonal
+	for (int i = 0; i < N; ++i) y[i] /= m_D[i];
+
+	// backward substitution L^T*x = z
+	for (int s = m_nsuper - 1; s >= 0; --s)
+	{
+		const int f = m_sfirst[s];
+		const int ns = m_sfirst[s + 1] - f;
+		const int m = m_srowp[s + 1] - m_srowp[s];
+		const int* R = &m_srow[0] + m_srowp[s];
+		const double* L = &m_Lx[0] + m_Lp[s];
+		for (int k = ns - 1; k >= 0; --k)
+		{
+			const double* Lk = L + (size_t)k*m;
+			double yk = y[f + k];
+			for (int i = k + 1; i < m; ++i) yk -= Lk[i] * y[R[i]];
+			y[f + k] = yk;
+		}
+	}
+
+	for (int i = 0; i < N; ++i) x[m_perm[i]] = y[i];
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::Destroy()
+{
+	m_Lx.clear();
+	m_D.clear();
+	m_U.clear();
+	m_relpos.clear();
+	LinearSolver::Destroy();
+}
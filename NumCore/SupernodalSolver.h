@@ -0,0 +1,121 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactSymmMatrix.h"
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+//! This class implements a multithreaded supernodal sparse LDL^T solver for
+//! symmetric matrices. 
+
+//! The PreProcess function calculates a fill-reducing (nested dissection)
+//! ordering and the symbolic factorization (elimination tree, supernodes and
+//! the row structure of the factor). The Factor function does the numerical 
+//! factorization using the multifrontal method. Supernodes that are on the 
+//! same level of the assembly tree are factored in parallel. Near the root,
+//! where there are only a few (but large) supernodes, the dense frontal 
+//! matrix updates are parallelized instead. No pivoting is done, so the 
+//! matrix must be factorizable without pivoting (e.g. positive definite).
+class SupernodalSolver : public LinearSolver
+{
+public:
+	//! constructor
+	SupernodalSolver(FEModel* fem);
+
+	//! destructor
+	~SupernodalSolver();
+
+	//! Preprocess (ordering and symbolic factorization)
+	bool PreProcess() override;
+
+	//! Factor matrix (numerical factorization)
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(double* x, double* b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+private:
+	// calculate the nested dissection ordering
+	void NestedDissection(const vector<int>& xadj, const vector<int>& adj);
+
+	// build the permuted (lower-triangular) matrix structure and the map from A
+	void BuildPermutedMatrix();
+
+	// calculate the elimination tree of the permuted matrix
+	void EliminationTree(vector<int>& parent);
+
+	// do the symbolic factorization (build the supernodes and their row structures)
+	bool SymbolicFactor();
+
+	// factor one supernode (parallel = parallelize the dense updates)
+	void FactorSupernode(int s, vector<int>& relpos, bool parallel);
+
+private:
+	CompactSymmMatrix*	m_pA;		//!< the matrix to factor
+
+	int	m_neq;	//!< number of equations
+
+	// ordering
+	vector<int>	m_perm;		//!< new to old equation number
+	vector<int>	m_iperm;	//!< old to new equation number
+
+	// permuted lower-triangular matrix (compressed column storage)
+	vector<int>		m_Cp;	//!< column pointers
+	vector<int>		m_Ci;	//!< row indices
+	vector<double>	m_Cx;	//!< values
+	vector<int>		m_Amap;	//!< position in C for each value of A
+
+	// supernodes
+	int				m_nsuper;	//!< number of supernodes
+	vector<int>		m_sfirst;	//!< first column of each supernode (size = m_nsuper + 1)
+	vector<int>		m_sparent;	//!< parent supernode in the assembly tree
+	vector<int>		m_schild;	//!< children of supernodes (use m_schildp to index)
+	vector<int>		m_schildp;	//!< start of children list of each supernode
+	vector<int>		m_srowp;	//!< start of row structure of each supernode
+	vector<int>		m_srow;		//!< row structure of all supernodes
+	vector<int>		m_level;	//!< supernodes sorted by level in the assembly tree
+	vector<int>		m_levelp;	//!< start index of each level in m_level
+
+	// numerical factor
+	vector<size_t>			m_Lp;	//!< start of each supernode's dense block in m_Lx
+	vector<double>			m_Lx;	//!< dense column-major blocks of L (unit diagonal is not used)
+	vector<double>			m_D;	//!< diagonal D
+	vector< vector<double> >	m_U;	//!< update matrices of supernodes
+	vector< vector<int> >		m_relpos;	//!< (per thread) position of a row in the current front
+	std::atomic<bool>		m_bfail;	//!< set when a zero pivot was encountered (by any thread)
+};